@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+	template <class T>
+	inline void do_not_optimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const T* sink;
+		sink = &value;
+#endif
+	}
+
+	// Best of several runs, in nanoseconds per processed element. Small inputs are
+	// repeated within a run so every run covers roughly a million elements.
+	template <class Func>
+	double measure(std::size_t elements, Func&& fn, int runs = 7)
+	{
+		elements = std::max<std::size_t>(elements, 1);
+		std::size_t repeats = std::max<std::size_t>(1, (std::size_t{ 1 } << 20) / elements);
+		double best = 1e300;
+		for (int run = 0; run < runs; ++run)
+		{
+			auto start = std::chrono::steady_clock::now();
+			for (std::size_t i = 0; i < repeats; ++i) fn();
+			auto stop = std::chrono::steady_clock::now();
+			best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+		}
+		return best / static_cast<double>(elements * repeats);
+	}
+
+	struct Result
+	{
+		std::string group;
+		std::string name;
+		std::string type;
+		std::size_t size;
+		double ns_per_element;
+	};
+
+	// Collects results of every benchmark whose group matches the filter and
+	// writes them as JSON. Progress goes to stderr so stdout stays parseable.
+	class Suite
+	{
+	public:
+		explicit Suite(std::string filter = {}) : _filter(std::move(filter)) {}
+
+		bool enabled(const std::string& group) const { return _filter.empty() || group.find(_filter) != std::string::npos; }
+
+		template <class Func>
+		void run(const std::string& group, const std::string& name, const std::string& type, std::size_t size, Func&& fn)
+		{
+			if (!enabled(group)) return;
+			double ns = measure(size, fn);
+			std::fprintf(stderr, "%-12s %-64s %-12s %9zu %10.3f ns/element\n", group.c_str(), name.c_str(), type.c_str(), size, ns);
+			_results.push_back({ group, name, type, size, ns });
+		}
+
+		const std::vector<Result>& results() const { return _results; }
+
+		void write_json(std::FILE* out) const
+		{
+			std::fprintf(out, "{\n  \"unit\": \"ns/element\",\n  \"benchmarks\": [");
+			for (std::size_t i = 0; i < _results.size(); ++i)
+			{
+				const Result& r = _results[i];
+				std::fprintf(out, "%s\n    { \"group\": \"%s\", \"name\": \"%s\", \"type\": \"%s\", \"size\": %zu, \"ns_per_element\": %.4f }",
+					i == 0 ? "" : ",", escaped(r.group).c_str(), escaped(r.name).c_str(), escaped(r.type).c_str(), r.size, r.ns_per_element);
+			}
+			std::fprintf(out, "\n  ]\n}\n");
+		}
+
+	private:
+		std::string _filter;
+		std::vector<Result> _results;
+
+		static std::string escaped(const std::string& s)
+		{
+			std::string out;
+			for (char c : s)
+			{
+				if (c == '"' || c == '\\') out += '\\';
+				out += c;
+			}
+			return out;
+		}
+	};
+
+	void pipelines(Suite& suite);
+	void containers(Suite& suite);
+}
@@ -0,0 +1,139 @@
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <uutils/static_vector.h>
+
+#include "bench.h"
+
+namespace
+{
+	template <class T>
+	T make_value(std::size_t i)
+	{
+		if constexpr (std::is_same_v<T, std::string>) return "value " + std::to_string(i);
+		else return static_cast<T>(i);
+	}
+
+	template <class T>
+	std::size_t weight(const T& value)
+	{
+		if constexpr (std::is_same_v<T, std::string>) return value.size();
+		else return static_cast<std::size_t>(value);
+	}
+
+	template <class T>
+	bool odd(const T& value) { return weight(value) % 2 == 1; }
+
+	// The same operations on StaticVector<T, N>, std::vector<T> and, where it has
+	// an equivalent, std::array<T, N>. Containers live on the heap so large N does
+	// not blow the stack, and are reused between repeats like a per-packet buffer.
+	template <class T, std::size_t N>
+	void run(bench::Suite& suite, const char* type)
+	{
+		auto add = [&](const char* name, auto&& fn) { suite.run("containers", name, type, N, fn); };
+
+		auto static_vector = std::make_unique<uutils::StaticVector<T, N>>();
+		auto array = std::make_unique<std::array<T, N>>();
+		std::vector<T> vector;
+		vector.reserve(N);
+
+		add("fill / StaticVector", [&]
+		{
+			static_vector->clear();
+			for (std::size_t i = 0; i < N; ++i) static_vector->push_back(make_value<T>(i));
+			bench::do_not_optimize(static_vector->data());
+		});
+		add("fill / std::vector reused", [&]
+		{
+			vector.clear();
+			for (std::size_t i = 0; i < N; ++i) vector.push_back(make_value<T>(i));
+			bench::do_not_optimize(vector.data());
+		});
+		add("fill / std::vector fresh", [&]
+		{
+			std::vector<T> fresh;
+			for (std::size_t i = 0; i < N; ++i) fresh.push_back(make_value<T>(i));
+			bench::do_not_optimize(fresh.data());
+		});
+		add("fill / std::array", [&]
+		{
+			for (std::size_t i = 0; i < N; ++i) (*array)[i] = make_value<T>(i);
+			bench::do_not_optimize(array->data());
+		});
+
+		add("iterate / StaticVector", [&]
+		{
+			std::size_t total = 0;
+			for (const T& v : *static_vector) total += weight(v);
+			bench::do_not_optimize(total);
+		});
+		add("iterate / std::vector", [&]
+		{
+			std::size_t total = 0;
+			for (const T& v : vector) total += weight(v);
+			bench::do_not_optimize(total);
+		});
+		add("iterate / std::array", [&]
+		{
+			std::size_t total = 0;
+			for (const T& v : *array) total += weight(v);
+			bench::do_not_optimize(total);
+		});
+
+		add("copy / StaticVector", [&]
+		{
+			auto copy = std::make_unique<uutils::StaticVector<T, N>>(*static_vector);
+			bench::do_not_optimize(copy->data());
+		});
+		add("copy / std::vector", [&]
+		{
+			auto copy = vector;
+			bench::do_not_optimize(copy.data());
+		});
+
+		// Refill, then drop every odd element
+		add("fill + erase_if / StaticVector", [&]
+		{
+			static_vector->clear();
+			for (std::size_t i = 0; i < N; ++i) static_vector->push_back(make_value<T>(i));
+			static_vector->erase_if([](const T& v) { return odd(v); });
+			bench::do_not_optimize(static_vector->data());
+		});
+		add("fill + erase_if / std::vector", [&]
+		{
+			vector.clear();
+			for (std::size_t i = 0; i < N; ++i) vector.push_back(make_value<T>(i));
+			std::erase_if(vector, [](const T& v) { return odd(v); });
+			bench::do_not_optimize(vector.data());
+		});
+
+		// Refill, then pop the front a few times as a queue-like buffer would
+		constexpr std::size_t pops = N < 16 ? N : 16;
+		add("fill + erase front / StaticVector", [&]
+		{
+			static_vector->clear();
+			for (std::size_t i = 0; i < N; ++i) static_vector->push_back(make_value<T>(i));
+			for (std::size_t i = 0; i < pops; ++i) static_vector->erase(static_vector->begin());
+			bench::do_not_optimize(static_vector->data());
+		});
+		add("fill + erase front / std::vector", [&]
+		{
+			vector.clear();
+			for (std::size_t i = 0; i < N; ++i) vector.push_back(make_value<T>(i));
+			for (std::size_t i = 0; i < pops; ++i) vector.erase(vector.begin());
+			bench::do_not_optimize(vector.data());
+		});
+	}
+}
+
+void bench::containers(Suite& suite)
+{
+	run<int, 16>(suite, "int");
+	run<int, 256>(suite, "int");
+	run<int, 4096>(suite, "int");
+	run<std::string, 16>(suite, "std::string");
+	run<std::string, 256>(suite, "std::string");
+	run<std::string, 4096>(suite, "std::string");
+}
@@ -0,0 +1,36 @@
+#include <cstdio>
+#include <cstring>
+
+#include "bench.h"
+
+// Usage: uutils_bench [--filter <group>] [--out <file.json>]
+// Without --out the JSON report is written to stdout.
+int main(int argc, char** argv)
+{
+	const char* filter = "";
+	const char* out_path = nullptr;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) filter = argv[++i];
+		else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_path = argv[++i];
+		else
+		{
+			std::fprintf(stderr, "usage: %s [--filter <group>] [--out <file.json>]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	bench::Suite suite(filter);
+	bench::pipelines(suite);
+	bench::containers(suite);
+
+	std::FILE* out = out_path ? std::fopen(out_path, "w") : stdout;
+	if (!out)
+	{
+		std::fprintf(stderr, "cannot open %s\n", out_path);
+		return 1;
+	}
+	suite.write_json(out);
+	if (out != stdout) std::fclose(out);
+	return 0;
+}
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <unordered_map>
+#include <vector>
+
+#include <uutils/data_processing.h>
+
+#include "bench.h"
+
+using namespace uutils::data_processing;
+
+namespace
+{
+	template <class T>
+	std::vector<T> random_data(std::size_t size)
+	{
+		std::vector<T> data(size);
+		std::mt19937 rng(42);
+		std::uniform_int_distribution<int> values(0, 999);
+		for (T& x : data) x = static_cast<T>(values(rng));
+		return data;
+	}
+
+	// Takes the range by non-const reference: std::views::filter is not const-iterable
+	template <class T>
+	T pull_sum(auto& pipeline)
+	{
+		T sum{};
+		for (auto&& item : pipeline) sum += item;
+		return sum;
+	}
+
+	// Every chain is measured through the push path that terminals take by default,
+	// by pulling through its iterators, as the std::ranges equivalent and as the loop
+	// one would write by hand.
+	template <class T>
+	void run(bench::Suite& suite, const char* type, std::size_t size)
+	{
+		const std::vector<T> data = random_data<T>(size);
+		auto square = [](T x) { return x * x; };
+		auto below = [](T x) { return x < T(250'000); };
+		auto shift = [](T x) { return x + T(3); };
+		auto even = [](T x) { return static_cast<long long>(x) % 2 == 0; };
+
+		auto add = [&](const char* name, auto&& fn) { suite.run("pipelines", name, type, size, fn); };
+
+		add("sum / uutils", [&] { bench::do_not_optimize(Range::from(data) > sum()); });
+		add("sum / std::accumulate", [&] { bench::do_not_optimize(std::accumulate(data.begin(), data.end(), T{})); });
+		add("sum / hand loop", [&]
+		{
+			T total{};
+			for (T x : data) total += x;
+			bench::do_not_optimize(total);
+		});
+
+		{
+			auto pipeline = Range::from(data) > map(square) > filter(below);
+			auto view = data | std::views::transform(square) | std::views::filter(below);
+			add("map > filter > sum / uutils push", [&] { bench::do_not_optimize(pipeline > sum()); });
+			add("map > filter > sum / uutils pull", [&] { bench::do_not_optimize(pull_sum<T>(pipeline)); });
+			add("map > filter > sum / std::ranges", [&] { bench::do_not_optimize(pull_sum<T>(view)); });
+			add("map > filter > sum / hand loop", [&]
+			{
+				T total{};
+				for (T x : data)
+				{
+					T v = square(x);
+					if (below(v)) total += v;
+				}
+				bench::do_not_optimize(total);
+			});
+		}
+
+		{
+			auto pipeline = Range::from(data) > map(square) > filter(below) > map(shift) > filter(even) > skip(16) > take(size / 2);
+			auto view = data | std::views::transform(square) | std::views::filter(below) | std::views::transform(shift)
+				| std::views::filter(even) | std::views::drop(16) | std::views::take(size / 2);
+			add("map > filter > map > filter > skip > take > sum / uutils push", [&] { bench::do_not_optimize(pipeline > sum()); });
+			add("map > filter > map > filter > skip > take > sum / uutils pull", [&] { bench::do_not_optimize(pull_sum<T>(pipeline)); });
+			add("map > filter > map > filter > skip > take > sum / std::ranges", [&] { bench::do_not_optimize(pull_sum<T>(view)); });
+			add("map > filter > map > filter > skip > take > sum / hand loop", [&]
+			{
+				T total{};
+				std::size_t skipped = 0, taken = 0;
+				for (T x : data)
+				{
+					T v = square(x);
+					if (!below(v)) continue;
+					v = shift(v);
+					if (!even(v)) continue;
+					if (skipped < 16) { ++skipped; continue; }
+					if (taken++ == size / 2) break;
+					total += v;
+				}
+				bench::do_not_optimize(total);
+			});
+		}
+
+		{
+			auto pipeline = Range::from(data) > filter(below) > map(shift);
+			auto view = data | std::views::filter(below) | std::views::transform(shift);
+			add("filter > map > to_vector / uutils", [&] { bench::do_not_optimize((pipeline > to_vector()).data()); });
+			add("filter > map > to_vector / std::ranges", [&]
+			{
+				std::vector<T> out;
+				for (T v : view) out.push_back(v);
+				bench::do_not_optimize(out.data());
+			});
+			add("filter > map > to_vector / hand loop", [&]
+			{
+				std::vector<T> out;
+				for (T x : data)
+					if (below(x)) out.push_back(shift(x));
+				bench::do_not_optimize(out.data());
+			});
+		}
+
+		{
+			// Values are uniform in [0, 1000), so about half pass: the worst case for branches
+			auto branchy = Range::from(data) > filter([](T x) { return x < T(500); });
+			auto selected = Range::from(data) > filter_simd(lt(T(500)));
+			add("filter 50% > sum / uutils lambda", [&] { bench::do_not_optimize(branchy > sum()); });
+			add("filter 50% > sum / uutils filter_simd", [&] { bench::do_not_optimize(selected > sum()); });
+			add("filter 50% > sum / hand loop", [&]
+			{
+				T total{};
+				for (T x : data)
+					if (x < T(500)) total += x;
+				bench::do_not_optimize(total);
+			});
+		}
+
+		{
+			// 1000 distinct keys
+			auto key = [](T x) { return static_cast<int>(x); };
+			add("group_by sum / uutils", [&] { bench::do_not_optimize((Range::from(data) > group_by(key, agg::sum())).size()); });
+			add("group_by sum / std::unordered_map", [&]
+			{
+				std::unordered_map<int, T> groups;
+				for (T x : data) groups[key(x)] += x;
+				bench::do_not_optimize(groups.size());
+			});
+		}
+
+		{
+			// Every element meets one of 100 dimension rows
+			std::vector<std::pair<int, T>> dimension;
+			for (int i = 0; i < 100; i++) dimension.emplace_back(i * 10, T(i));
+			auto key = [](T x) { return static_cast<int>(x) / 10 * 10; };
+			auto pipeline = Range::from(data) > hash_join(Range::from(dimension), key, [](const auto& row) { return row.first; })
+				> map([](const auto& p) { return p.first * p.second.second; });
+			add("hash_join > sum / uutils", [&] { bench::do_not_optimize(pipeline > sum()); });
+			add("hash_join > sum / nested loop", [&]
+			{
+				T total{};
+				for (T x : data)
+					for (const auto& row : dimension)
+						if (row.first == key(x)) total += x * row.second;
+				bench::do_not_optimize(total);
+			});
+		}
+
+		{
+			add("top 10 / uutils top_k", [&] { bench::do_not_optimize((Range::from(data) > top_k<10>()).data()); });
+			add("top 10 / to_vector + std::sort", [&]
+			{
+				auto copy = Range::from(data) > to_vector();
+				std::sort(copy.begin(), copy.end(), std::greater<>());
+				bench::do_not_optimize(copy.data());
+			});
+			add("sort / uutils sorted", [&] { bench::do_not_optimize((Range::from(data) > sorted()).data()); });
+			add("sort / to_vector + std::sort", [&]
+			{
+				auto copy = Range::from(data) > to_vector();
+				std::sort(copy.begin(), copy.end());
+				bench::do_not_optimize(copy.data());
+			});
+		}
+
+		{
+			// Clamping is idempotent, so every run does the same work on the same data
+			std::vector<T> buffer = data;
+			auto clamp = [](T x) { return std::clamp(x, T(100), T(900)); };
+			add("clamp in place / uutils transform_inplace", [&]
+			{
+				Range::from_mut(buffer) > transform_inplace(clamp);
+				bench::do_not_optimize(buffer.data());
+			});
+			add("clamp in place / uutils transform_inplace par", [&]
+			{
+				Range::from_mut(buffer) > transform_inplace(par, clamp);
+				bench::do_not_optimize(buffer.data());
+			});
+			add("clamp in place / to_vector + copy back", [&]
+			{
+				auto out = Range::from(buffer) > map(clamp) > to_vector();
+				std::copy(out.begin(), out.end(), buffer.begin());
+				bench::do_not_optimize(buffer.data());
+			});
+			add("clamp in place / hand loop", [&]
+			{
+				for (T& x : buffer) x = clamp(x);
+				bench::do_not_optimize(buffer.data());
+			});
+		}
+
+		{
+			constexpr std::size_t w = 64;
+			add("rolling max 64 / uutils", [&] { bench::do_not_optimize((Range::from(data) > rolling_max(w) > to_vector()).data()); });
+			add("rolling max 64 / window + max_element", [&]
+			{
+				auto out = Range::from(data) > window(w) > map([](std::span<const T> s) { return *std::max_element(s.begin(), s.end()); }) > to_vector();
+				bench::do_not_optimize(out.data());
+			});
+			add("rolling mean 64 / uutils", [&] { bench::do_not_optimize((Range::from(data) > rolling_mean(w) > to_vector()).data()); });
+			add("rolling mean 64 / window + accumulate", [&]
+			{
+				auto out = Range::from(data) > window(w)
+					> map([](std::span<const T> s) { return static_cast<double>(std::accumulate(s.begin(), s.end(), T{})) / s.size(); }) > to_vector();
+				bench::do_not_optimize(out.data());
+			});
+		}
+
+		{
+			add("prefix sums / uutils to_prefix_sums", [&] { bench::do_not_optimize((Range::from(data) > to_prefix_sums()).data()); });
+			add("prefix sums / uutils to_prefix_sums par", [&] { bench::do_not_optimize((Range::from(data) > to_prefix_sums(par)).data()); });
+			add("prefix sums / std::inclusive_scan", [&]
+			{
+				std::vector<T> sums(data.size());
+				std::inclusive_scan(data.begin(), data.end(), sums.begin());
+				bench::do_not_optimize(sums.data());
+			});
+		}
+
+		{
+			auto pipeline = Range::from(data) > map(square);
+			add("map > max / uutils", [&] { bench::do_not_optimize(pipeline > max()); });
+			add("map > max / std::ranges", [&] { bench::do_not_optimize(std::ranges::max(data | std::views::transform(square))); });
+		}
+	}
+}
+
+void bench::pipelines(Suite& suite)
+{
+	for (std::size_t size : { std::size_t{ 1 } << 10, std::size_t{ 1 } << 16, std::size_t{ 1 } << 22 })
+	{
+		run<int>(suite, "int", size);
+		run<long long>(suite, "long long", size);
+		run<double>(suite, "double", size);
+	}
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <uutils/arena.h>
+#include <uutils/data_processing.h>
+
+TEST(Arena, AllocationsAreAligned) {
+	uutils::Arena arena(64);
+
+	for (std::size_t alignment : { 1, 2, 4, 8, 16, 32, 64 })
+	{
+		void* p = arena.allocate(3, alignment);
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignment, 0u);
+	}
+}
+
+TEST(Arena, GrowsAndReleases) {
+	uutils::Arena arena(128);
+
+	std::vector<std::byte*> blocks;
+	for (int i = 0; i < 100; i++)
+	{
+		auto* p = static_cast<std::byte*>(arena.allocate(100, 8));
+		ASSERT_NE(p, nullptr);
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 8, 0u);
+		blocks.push_back(p);
+	}
+	EXPECT_GE(arena.upstream_bytes(), 10'000u);
+
+	// No two allocations overlap
+	std::sort(blocks.begin(), blocks.end(), [](std::byte* a, std::byte* b) { return std::less<>()(a, b); });
+	for (std::size_t i = 1; i < blocks.size(); i++)
+		EXPECT_GE(reinterpret_cast<std::uintptr_t>(blocks[i]) - reinterpret_cast<std::uintptr_t>(blocks[i - 1]), 100u);
+
+	arena.release();
+	EXPECT_EQ(arena.upstream_bytes(), 0u);
+}
+
+TEST(Arena, UsesInitialBufferFirst) {
+	alignas(16) std::byte buffer[256];
+	uutils::Arena arena(buffer, sizeof(buffer));
+
+	auto* p = static_cast<std::byte*>(arena.allocate(64, 16));
+	EXPECT_TRUE(p >= buffer && p < buffer + sizeof(buffer));
+	EXPECT_EQ(arena.upstream_bytes(), 0u);
+
+	auto* q = static_cast<std::byte*>(arena.allocate(512, 16));
+	ASSERT_NE(q, nullptr);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(q) % 16, 0u);
+	// Outside the buffer, which cannot fit it after the first allocation
+	EXPECT_FALSE(std::less_equal<>()(buffer, q) && std::less<>()(q, buffer + sizeof(buffer)));
+	EXPECT_GT(arena.upstream_bytes(), 0u);
+}
+
+TEST(Arena, Allocator) {
+	uutils::Arena arena;
+	std::vector<std::string, uutils::ArenaAllocator<std::string>> strings{ uutils::ArenaAllocator<std::string>(arena) };
+
+	for (int i = 0; i < 100; i++)
+		strings.push_back(std::to_string(i));
+
+	EXPECT_EQ(strings[42], "42");
+	EXPECT_GT(arena.upstream_bytes(), 0u);
+}
+
+TEST(Arena, PipelineToPmrVector) {
+	using namespace uutils::data_processing;
+	uutils::Arena arena;
+
+	auto result = range(0, 1000) > filter([](int x) { return x % 10 == 0; }) > to_pmr_vector(&arena);
+
+	EXPECT_EQ(result.size(), 100);
+	EXPECT_EQ(result.get_allocator().resource(), &arena);
+	EXPECT_GT(arena.upstream_bytes(), 0u);
+}
+
+TEST(Arena, PipelineToVectorWithAllocator) {
+	using namespace uutils::data_processing;
+	uutils::Arena arena;
+
+	auto result = range(0, 10) > map([](int x) { return x * 1.5; }) > to_vector(uutils::ArenaAllocator<std::byte>(arena));
+
+	static_assert(std::is_same_v<decltype(result), std::vector<double, uutils::ArenaAllocator<double>>>);
+	EXPECT_EQ(result.back(), 13.5);
+	EXPECT_EQ(result.get_allocator().arena(), &arena);
+}
@@ -1,7 +1,17 @@
-#include <gtest/gtest.h>
+﻿#include <gtest/gtest.h>
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <sstream>
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include <uutils/data_processing.h>
 
@@ -111,15 +121,21 @@ TEST(DataPipeline, Take_MoreThanDataSize_ReturnData) {
 	EXPECT_EQ(Range::from(data) > take(data.size() + 1) > to_vector(), expected);
 };
 
-TEST(DataPipeline, Reverse_CurrentlyDoesNotWorkProperly_TODO_FIX_LATER) {
+TEST(DataPipeline, Reverse) {
 	using namespace uutils::data_processing;
 
-	/*
 	std::array data = { 1, 2, 3, 4, 5 };
 	std::vector expected = { 5, 4, 3, 2, 1 };
 
-	EXPECT_EQ(Range::from(data) > reverse() > to_vector(), expected);*/
-	EXPECT_TRUE(true);
+	EXPECT_EQ(Range::from(data) > reverse() > to_vector(), expected);
+};
+
+TEST(DataPipeline, Reverse_Filtered) {
+	using namespace uutils::data_processing;
+
+	std::vector expected = { 9, 7, 5, 3, 1 };
+
+	EXPECT_EQ(range(0, 10) > filter([](int x) { return x % 2 == 1; }) > reverse() > to_vector(), expected);
 };
 
 TEST(DataPipeline, Range) {
@@ -183,4 +199,1139 @@ TEST(DataPipeline, Chain_V3) {
 	std::vector expected = { 1, 2, 3, 4, 5 };
 
 	EXPECT_EQ(Range::from("12345") > filter([](char x) { return x >= '0'; }) > map([](char x) { return (int)(x - '0'); }) > sum(), 15);
-};
\ No newline at end of file
+};
+
+TEST(DataPipeline, Parallel_Sum) {
+	using namespace uutils::data_processing;
+
+	std::vector<long long> data(1'000'000);
+	for (std::size_t i = 0; i < data.size(); i++) data[i] = static_cast<long long>(i);
+
+	long long expected = Range::from(data) > filter([](long long x) { return x % 3 == 0; }) > sum();
+
+	EXPECT_EQ(Range::from(data) > filter([](long long x) { return x % 3 == 0; }) > sum(par), expected);
+	EXPECT_EQ(Range::from(data) > map([](long long x) { return x * 2; }) > sum(parallel(3)), 999'999'000'000LL);
+};
+
+TEST(DataPipeline, Parallel_SumOfRange) {
+	using namespace uutils::data_processing;
+
+	EXPECT_EQ(range(0LL, 100'000LL) > sum(par), 4'999'950'000LL);
+};
+
+TEST(DataPipeline, Parallel_ToVector_KeepsOrder) {
+	using namespace uutils::data_processing;
+
+	auto expected = range(0, 200'000) > filter([](int x) { return x % 7 != 0; }) > map([](int x) { return x * 3; }) > to_vector();
+
+	EXPECT_EQ(range(0, 200'000) > filter([](int x) { return x % 7 != 0; }) > map([](int x) { return x * 3; }) > to_vector(par), expected);
+};
+
+TEST(DataPipeline, Parallel_AllAnyNone) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data(500'000, 1);
+	data[123'456] = -1;
+
+	EXPECT_FALSE(Range::from(data) > all(par, [](int x) { return x > 0; }));
+	EXPECT_TRUE(Range::from(data) > any(par, [](int x) { return x < 0; }));
+	EXPECT_FALSE(Range::from(data) > none(par, [](int x) { return x < 0; }));
+	EXPECT_TRUE(Range::from(data) > none(par, [](int x) { return x > 1; }));
+};
+
+TEST(DataPipeline, Parallel_NotSplittable_FallsBackToSequential) {
+	using namespace uutils::data_processing;
+
+	std::array data = { 1, 2, 3, 4, 5 };
+
+	EXPECT_EQ(Range::from(data) > skip(1) > sum(par), 14);
+};
+
+TEST(DataPipeline, Sum_Vectorized) {
+	using namespace uutils::data_processing;
+
+	for (int size : { 0, 1, 7, 33, 1000 })
+	{
+		std::vector<int> data(size);
+		long long expected = 0;
+		for (int i = 0; i < size; i++)
+		{
+			data[i] = i * 37 % 101 - 50;
+			expected += data[i] * 3;
+		}
+
+		EXPECT_EQ(Range::from(data) > map([](int x) { return x * 3; }) > sum(), expected);
+
+		// Narrow types go through the scalar block sum
+		std::vector<short> shorts(data.begin(), data.end());
+		EXPECT_EQ(Range::from(shorts) > sum(), static_cast<short>(expected / 3));
+	}
+};
+
+TEST(DataPipeline, Sum_Reassociate) {
+	using namespace uutils::data_processing;
+
+	std::vector<float> data(1000, 0.5f);
+
+	EXPECT_FLOAT_EQ(Range::from(data) > sum(reassociate), 500.0f);
+	EXPECT_DOUBLE_EQ(Range::from(data) > map([](float x) { return static_cast<double>(x) * 2; }) > sum(reassociate), 1000.0);
+};
+
+TEST(DataPipeline, MinMax) {
+	using namespace uutils::data_processing;
+
+	std::vector<double> data(100);
+	for (int i = 0; i < 100; i++) data[i] = (i * 37 % 101) - 50.5;
+
+	EXPECT_EQ(Range::from(data) > min(), -50.5);
+	EXPECT_EQ(Range::from(data) > max(), 49.5);
+	EXPECT_EQ(Range::from(data) > minmax(), std::make_pair(-50.5, 49.5));
+	EXPECT_EQ(Range::from(data) > map([](double x) { return static_cast<long long>(x * -2); }) > minmax(), std::make_pair(-99LL, 101LL));
+	EXPECT_EQ(range(3, 10) > filter([](int x) { return x % 2 == 0; }) > minmax(), std::make_pair(4, 12));
+};
+
+TEST(DataPipeline, MinMax_EmptyThrows) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data;
+
+	EXPECT_THROW(Range::from(data) > min(), std::out_of_range);
+	EXPECT_THROW(Range::from(data) > max(), std::out_of_range);
+	EXPECT_THROW(range(0, 0) > minmax(), std::out_of_range);
+};
+
+TEST(DataPipeline, Count) {
+	using namespace uutils::data_processing;
+
+	std::array data = { 1, 2, 3, 4, 5 };
+
+	EXPECT_EQ(Range::from(data) > count(), 5);
+	EXPECT_EQ(Range::from(data) > filter([](int x) { return x > 2; }) > count(), 3);
+	EXPECT_EQ(Range::from(data) > count([](int x) { return x % 2 == 0; }), 2);
+};
+
+
+TEST(DataPipeline, Size_PropagatesThroughAdaptors) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data(100);
+
+	EXPECT_EQ((Range::from(data) > map([](int x) { return x + 1; })).size(), 100);
+	EXPECT_EQ((Range::from(data) > skip(30) > take(50)).size(), 50);
+	EXPECT_EQ((Range::from(data) > skip(90) > take(50)).size(), 10);
+	EXPECT_EQ((Range::from(data) > reverse() > skip(200)).size(), 0);
+	EXPECT_EQ((range(5, 10) > take(-1)).size(), 0);
+};
+
+TEST(DataPipeline, IteratorCategories) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data;
+	auto mapped = Range::from(data) > map([](int x) { return x; });
+	auto filtered = Range::from(data) > filter([](int x) { return x > 0; });
+
+	static_assert(std::is_same_v<decltype(mapped.begin())::iterator_category, std::random_access_iterator_tag>);
+	static_assert(std::is_same_v<decltype((mapped > reverse()).begin())::iterator_category, std::random_access_iterator_tag>);
+	static_assert(std::is_same_v<decltype(filtered.begin())::iterator_category, std::bidirectional_iterator_tag>);
+	static_assert(std::is_same_v<decltype(range(0, 5).begin())::iterator_category, std::random_access_iterator_tag>);
+	EXPECT_TRUE(mapped.begin() == mapped.end());
+};
+
+TEST(DataPipeline, SkipTake_RandomAccessIsConstantTime) {
+	using namespace uutils::data_processing;
+
+	std::vector<long long> expected = { 999'999'999'997LL, 999'999'999'998LL };
+
+	EXPECT_EQ(range(0LL, 1'000'000'000'000LL) > skip(999'999'999'997LL) > take(2) > to_vector(), expected);
+	EXPECT_EQ(range(0LL, 1'000'000'000'000LL) > reverse() > skip(1) > take(2) > to_vector(), (std::vector<long long>{ 999'999'999'998LL, 999'999'999'997LL }));
+};
+
+TEST(DataPipeline, Take_Filtered_WalksOnce) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data(1000);
+	std::iota(data.begin(), data.end(), 0);
+	int calls = 0;
+	auto first = Range::from(data) > filter([&calls](int x) { calls++; return x % 10 == 0; }) > take(3);
+	static_assert(!detail::CommonRange<decltype(first)>);
+	static_assert(detail::CommonRange<decltype(Range::from(data) > take(3))>);
+
+	// Pulled, so the end has to be found without walking; stops on the third match
+	std::vector<int> pulled;
+	for (int x : first) pulled.push_back(x);
+	EXPECT_EQ(pulled, std::vector<int>({ 0, 10, 20 }));
+	EXPECT_EQ(calls, 21);
+
+	// Everything downstream of a sentinel ends in one too
+	std::vector<int> mapped;
+	for (int x : first > map([](int x) { return x + 1; }) > skip(1)) mapped.push_back(x);
+	EXPECT_EQ(mapped, std::vector<int>({ 11, 21 }));
+
+	EXPECT_EQ(first > reverse() > to_vector(), std::vector<int>({ 20, 10, 0 }));
+	EXPECT_EQ(Range::from(data) > filter([](int x) { return x < 2; }) > take(5) > reverse() > to_vector(), std::vector<int>({ 1, 0 }));
+	EXPECT_EQ(Range::from(data) > take(0) > to_vector(), std::vector<int>());
+	EXPECT_EQ(first > take(-1) > to_vector(), std::vector<int>());
+
+	auto chunks = first > chunk(2) > map([](std::span<const int> c) { return c.size(); });
+	std::vector<std::size_t> sizes;
+	for (std::size_t n : chunks) sizes.push_back(n);
+	EXPECT_EQ(sizes, std::vector<std::size_t>({ 2, 1 }));
+
+	std::vector<std::pair<int, int>> zipped;
+	for (auto p : first > zip(Range::from(data))) zipped.push_back(p);
+	EXPECT_EQ(zipped, (std::vector<std::pair<int, int>>{ { 0, 0 }, { 10, 1 }, { 20, 2 } }));
+
+	std::vector<int> keys = { 10, 20 };
+	std::size_t joined = 0;
+	for (auto p : first > hash_join(Range::from(keys), [](int x) { return x; }, [](int x) { return x; })) joined += p.first == p.second;
+	EXPECT_EQ(joined, 2u);
+};
+
+TEST(DataPipeline, Parallel_SkipTakeReverse) {
+	using namespace uutils::data_processing;
+
+	auto expected = range(0, 300'000) > skip(1234) > take(200'000) > reverse() > map([](int x) { return x * 2; }) > to_vector();
+
+	EXPECT_EQ(range(0, 300'000) > skip(1234) > take(200'000) > reverse() > map([](int x) { return x * 2; }) > to_vector(par), expected);
+	EXPECT_EQ(expected.front(), 2 * (1234 + 200'000 - 1));
+};
+
+TEST(DataPipeline, Filter_AfterMap_CallsMapOncePerElement) {
+	using namespace uutils::data_processing;
+
+	int calls = 0;
+	auto expensive = [&calls](int x) { calls++; return std::to_string(x); };
+
+	std::size_t total = range(0, 100) > map(expensive) > filter([](const std::string& s) { return s.size() == 2; }) > map([](const std::string& s) { return s.size(); }) > sum();
+
+	EXPECT_EQ(total, 180u);
+	EXPECT_EQ(calls, 100);
+};
+
+TEST(DataPipeline, Filter_AfterMap_Reverse) {
+	using namespace uutils::data_processing;
+
+	std::vector<std::string> expected = { "8", "6", "4", "2", "0" };
+
+	EXPECT_EQ(range(0, 10) > map([](int x) { return std::to_string(x); }) > filter([](const std::string& s) { return (s[0] - '0') % 2 == 0; }) > reverse() > to_vector(), expected);
+};
+
+TEST(DataPipeline, Cache) {
+	using namespace uutils::data_processing;
+
+	int calls = 0;
+	auto cached = range(0, 5) > map([&calls](int x) { calls++; return x * 10; }) > cache();
+
+	int sum = 0;
+	for (auto it = cached.begin(); it != cached.end(); ++it)
+		sum += *it + *it;
+
+	EXPECT_EQ(sum, 200);
+	EXPECT_EQ(calls, 5);
+	EXPECT_EQ(cached.size(), 5);
+};
+
+TEST(DataPipeline, Cache_AfterSentinel) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data(100);
+	std::iota(data.begin(), data.end(), 0);
+	auto even = [](int x) { return x % 2 == 0; };
+
+	std::vector<int> taken;
+	for (int x : Range::from(data) > filter(even) > take(2) > cache()) taken.push_back(x);
+	EXPECT_EQ(taken, std::vector<int>({ 0, 2 }));
+
+	int filtered = 0;
+	for (int x : Range::from(data) > filter(even) > cache()) filtered += x;
+	EXPECT_EQ(filtered, 2450);
+
+	std::vector<std::string_view> short_lines;
+	for (auto line : std::string_view("a\nbb\nc") > lines() > filter([](std::string_view l) { return l.size() == 1; }) > cache()) short_lines.push_back(line);
+	EXPECT_EQ(short_lines, std::vector<std::string_view>({ "a", "c" }));
+};
+
+TEST(DataPipeline, Push_MatchesPull) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data(1000);
+	for (int i = 0; i < 1000; i++) data[i] = i * 7 % 13;
+
+	auto pipeline = Range::from(data)
+		> map([](int x) { return x * 3; })
+		> filter([](int x) { return x % 2 == 0; })
+		> skip(10)
+		> take(300)
+		> reverse()
+		> map([](int x) { return x + 1; });
+
+	static_assert(detail::Pushable<decltype(pipeline)>);
+
+	std::vector<int> pulled;
+	for (auto&& item : pipeline) pulled.push_back(item);
+
+	EXPECT_EQ(pipeline > to_vector(), pulled);
+};
+
+TEST(DataPipeline, Push_TakeStopsEarly) {
+	using namespace uutils::data_processing;
+
+	int calls = 0;
+	auto counted = [&calls](int x) { calls++; return x; };
+
+	EXPECT_EQ(range(0, 1'000'000) > filter([](int x) { return x % 2 == 0; }) > map(counted) > take(3) > sum(), 6);
+	EXPECT_EQ(calls, 3);
+
+	calls = 0;
+	EXPECT_TRUE(range(0, 1'000'000) > map(counted) > any([](int x) { return x == 10; }));
+	EXPECT_EQ(calls, 11);
+};
+
+TEST(DataPipeline, ToStaticVector) {
+	using namespace uutils::data_processing;
+
+	auto result = range(0, 10) > filter([](int x) { return x % 3 == 0; }) > to_static_vector<4>();
+
+	EXPECT_EQ(result.size(), 4);
+	EXPECT_EQ(result[3], 9);
+	EXPECT_THROW(range(0, 10) > filter([](int x) { return x % 2 == 0; }) > to_static_vector<4>(), std::length_error);
+	EXPECT_THROW(range(0, 10) > to_static_vector<4>(), std::length_error);
+};
+
+TEST(DataPipeline, ToStaticVector_Truncate) {
+	using namespace uutils::data_processing;
+
+	auto result = range(0, 10) > map([](int x) { return std::to_string(x); }) > to_static_vector<3>(truncating);
+
+	EXPECT_EQ(result.size(), 3);
+	EXPECT_EQ(result.back(), "2");
+};
+
+TEST(DataPipeline, Into_Span) {
+	using namespace uutils::data_processing;
+
+	std::array<int, 8> buffer{};
+	auto written = range(1, 5) > map([](int x) { return x * x; }) > into(buffer);
+
+	EXPECT_EQ(written.size(), 5);
+	EXPECT_EQ(written.data(), buffer.data());
+	EXPECT_EQ(buffer[4], 25);
+	EXPECT_THROW(range(0, 9) > into(buffer), std::length_error);
+	EXPECT_EQ((range(0, 100) > filter([](int x) { return x % 2 == 1; }) > into(buffer, truncating)).size(), 8);
+	EXPECT_EQ(buffer[7], 15);
+};
+
+TEST(DataPipeline, Into_OutputIterator) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> out;
+	range(0, 3) > into(std::back_inserter(out));
+
+	int raw[4] = {};
+	int* end = range(7, 4) > into(&raw[0]);
+
+	EXPECT_EQ(out, (std::vector{ 0, 1, 2 }));
+	EXPECT_EQ(end, raw + 4);
+	EXPECT_EQ(raw[3], 10);
+};
+
+
+TEST(DataPipeline, Range_FromMmap) {
+	using namespace uutils::data_processing;
+
+	struct Record { int id; float value; };
+	auto path = std::filesystem::temp_directory_path() / "uutils_test_from_mmap.bin";
+	{
+		std::ofstream file(path, std::ios::binary);
+		for (int i = 0; i < 10000; i++)
+		{
+			Record record{ i, i * 0.5f };
+			file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+		}
+	}
+
+	auto records = Range::from_mmap<Record>(path);
+	auto ids = Range::from_mmap<int>(path) > filter([](int) { return true; }) > take(2) > to_vector();
+	auto last = records > reverse() > map([](const Record& r) { return r.id; }) > take(1) > to_vector();
+	auto total = records > map([](const Record& r) { return static_cast<long long>(r.id); }) > sum(par);
+
+	EXPECT_EQ(records.size(), 10000);
+	EXPECT_EQ(ids, (std::vector{ 0, 0 }));
+	EXPECT_EQ(last, (std::vector{ 9999 }));
+	EXPECT_EQ(total, 9999LL * 10000 / 2);
+	EXPECT_THROW((Range::from_mmap<std::array<char, 7>>(path)), std::length_error);
+	EXPECT_THROW(Range::from_mmap<int>(path.string() + ".missing"), std::system_error);
+
+	std::filesystem::remove(path);
+};
+
+TEST(DataPipeline, Split) {
+	using namespace uutils::data_processing;
+
+	std::string csv = "id,,name,";
+	auto fields = Range::from(csv) > split(',') > to_vector();
+	auto none = std::string_view() > split(',') > to_vector();
+
+	EXPECT_EQ(fields, (std::vector<std::string_view>{ "id", "", "name", "" }));
+	EXPECT_EQ(fields[0].data(), csv.data());
+	EXPECT_TRUE(none.empty());
+	EXPECT_EQ(std::string_view("a;b;c") > split(';') > count(), 3);
+};
+
+TEST(DataPipeline, Lines) {
+	using namespace uutils::data_processing;
+
+	std::string_view log = "INFO start\r\nERROR disk full\n\nERROR timeout\n";
+	auto all = log > lines() > to_vector();
+	auto errors = log > lines() > filter([](std::string_view line) { return line.starts_with("ERROR"); })
+		> map([](std::string_view line) { return line.size(); }) > sum();
+
+	EXPECT_EQ(all, (std::vector<std::string_view>{ "INFO start", "ERROR disk full", "", "ERROR timeout" }));
+	EXPECT_EQ(errors, 28);
+	EXPECT_EQ(std::string_view("no newline") > lines() > count(), 1);
+
+	std::string long_line(1000, 'x');
+	long_line += "\nlast";
+	EXPECT_EQ((Range::from(long_line) > lines() > to_vector()).back(), "last");
+};
+
+TEST(DataPipeline, Lines_FromMmap) {
+	using namespace uutils::data_processing;
+
+	auto path = std::filesystem::temp_directory_path() / "uutils_test_lines.txt";
+	{
+		std::ofstream file(path, std::ios::binary);
+		for (int i = 0; i < 1000; i++) file << "line " << i << "\n";
+	}
+
+	auto numbers = Range::from_mmap<char>(path) > lines()
+		> map([](std::string_view line) { return std::stoi(std::string(line.substr(5))); });
+	EXPECT_EQ(numbers > sum(), 999 * 1000 / 2);
+
+	std::filesystem::remove(path);
+};
+
+TEST(DataPipeline, Buffered) {
+	using namespace uutils::data_processing;
+
+	auto pipeline = range(0, 100000) > map([](int x) { return static_cast<long long>(x) * 2; }) > buffered(256)
+		> filter([](long long x) { return x % 3 == 0; });
+
+	long long pulled = 0;
+	for (long long x : pipeline) pulled += x;
+
+	EXPECT_EQ(pipeline > sum(), pulled);
+	EXPECT_EQ(pipeline > count(), 33334);
+	EXPECT_EQ(range(0, 10) > buffered(3) > to_vector(), (range(0, 10) > to_vector()));
+	EXPECT_EQ(range(0, 0) > buffered() > count(), 0);
+
+	// Upstreams with move-only callables cannot be copied into the worker
+	auto scaled = range(0, 1000) > map([factor = std::make_unique<int>(3)](int x) { return x * *factor; }) > buffered(64);
+	EXPECT_EQ(scaled > sum(), 3 * 999 * 1000 / 2);
+	long long scaled_pulled = 0;
+	for (int x : scaled) scaled_pulled += x;
+	EXPECT_EQ(scaled_pulled, 3 * 999 * 1000 / 2);
+};
+
+TEST(DataPipeline, Buffered_EarlyStopAndErrors) {
+	using namespace uutils::data_processing;
+
+	// take stops the consumer long before the producer is done
+	auto first = range(0, 1 << 30) > buffered(64) > take(5) > to_vector();
+	EXPECT_EQ(first, (std::vector{ 0, 1, 2, 3, 4 }));
+
+	std::vector<std::string> words{ "a", "b", "c" };
+	auto moved = Range::from(words) > map([](const std::string& s) { return s + s; }) > buffered(1) > to_vector();
+	EXPECT_EQ(moved, (std::vector<std::string>{ "aa", "bb", "cc" }));
+
+	auto failing = range(0, 1000) > map([](int x) { if (x == 500) throw std::runtime_error("decode"); return x; }) > buffered(16);
+	EXPECT_THROW(failing > sum(), std::runtime_error);
+};
+
+TEST(DataPipeline, Chunk) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data{ 1, 2, 3, 4, 5, 6, 7 };
+	auto chunks = Range::from(data) > chunk(3);
+	std::vector<std::size_t> sizes;
+	for (std::span<const int> span : chunks) sizes.push_back(span.size());
+
+	EXPECT_EQ(chunks.size(), 3);
+	EXPECT_EQ(sizes, (std::vector<std::size_t>{ 3, 3, 1 }));
+	EXPECT_EQ((*chunks.begin()).data(), data.data());
+	EXPECT_EQ(chunks > map([](std::span<const int> s) { return s.back(); }) > to_vector(), (std::vector{ 3, 6, 7 }));
+	EXPECT_EQ(chunks > map([](std::span<const int> s) { return s.size(); }) > sum(par), 7);
+};
+
+TEST(DataPipeline, Chunk_NonContiguous) {
+	using namespace uutils::data_processing;
+
+	auto evens = range(0, 20) > filter([](int x) { return x % 2 == 0; }) > chunk(4);
+	std::vector<int> firsts;
+	for (std::span<const int> span : evens) firsts.push_back(span.front());
+
+	EXPECT_EQ(firsts, (std::vector{ 0, 8, 16 }));
+	EXPECT_EQ(evens > map([](std::span<const int> s) { return static_cast<int>(s.size()); }) > to_vector(), (std::vector{ 4, 4, 2 }));
+	EXPECT_EQ(evens > take(1) > count(), 1);
+};
+
+TEST(DataPipeline, MapBatch) {
+	using namespace uutils::data_processing;
+
+	auto twice = [](std::span<const int> in, std::span<long long> out)
+	{
+		for (std::size_t i = 0; i < in.size(); i++) out[i] = in[i] * 2LL;
+	};
+	auto doubled = range(0, 1000) > map_batch<long long>(twice, 64);
+
+	long long pulled = 0;
+	for (long long x : doubled) pulled += x;
+
+	EXPECT_EQ(doubled.size(), 1000);
+	EXPECT_EQ(doubled > sum(), 999LL * 1000);
+	EXPECT_EQ(pulled, 999LL * 1000);
+	EXPECT_EQ(doubled > skip(998) > to_vector(), (std::vector<long long>{ 1996, 1998 }));
+};
+
+TEST(DataPipeline, ForEachBatch) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data(1000, 1);
+	std::size_t calls = 0;
+	int total = 0;
+	Range::from(data) > for_each_batch([&](std::span<const int> batch)
+	{
+		calls++;
+		for (int x : batch) total += x;
+	}, 300);
+
+	EXPECT_EQ(calls, 4);
+	EXPECT_EQ(total, 1000);
+};
+
+TEST(DataPipeline, FilterSimd) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> ints;
+	for (int i = 0; i < 1000; i++) ints.push_back((i * 7919) % 1000);
+	std::vector<double> doubles(ints.begin(), ints.end());
+	doubles[3] = std::numeric_limits<double>::quiet_NaN();
+
+	auto reference = [&](auto pred) { return Range::from(ints) > filter([=](int x) { return pred(x); }) > to_vector(); };
+
+	EXPECT_EQ(Range::from(ints) > filter_simd(lt(500)) > to_vector(), reference(lt(500)));
+	EXPECT_EQ(Range::from(ints) > filter(ge(900)) > to_vector(), reference(ge(900)));
+	EXPECT_EQ(Range::from(ints) > filter(between(10, 20)) > count(), 11);
+	EXPECT_EQ(Range::from(ints) > filter(ne(0)) > count(), 999);
+	EXPECT_EQ(Range::from(ints) > filter(eq(7)) > take(1) > to_vector(), (std::vector{ 7 }));
+	EXPECT_EQ(Range::from(ints) > map([](int x) { return static_cast<long long>(x) * 3; }) > filter(gt(2900LL)) > sum(), 3LL * (967 + 999) * 33 / 2);
+	EXPECT_EQ(Range::from(ints) > filter(le(1)) > sum(par), 1);
+
+	// NaN fails every comparison except !=
+	EXPECT_EQ(Range::from(doubles) > filter(lt(1e9)) > count(), 999);
+	EXPECT_EQ(Range::from(doubles) > filter(ne(-1.0)) > count(), 1000);
+
+	// Pulled through iterators the same predicate runs per element
+	int pulled = 0;
+	for (int x : Range::from(ints) > filter(lt(3))) pulled += x;
+	EXPECT_EQ(pulled, 3);
+};
+TEST(DataPipeline, FilterSimd_InexactBounds) {
+	using namespace uutils::data_processing;
+
+	// Pushed terminals must agree with walking the iterators when the bound does not
+	// fit the element type
+	auto pulled = [](auto pipeline)
+	{
+		std::vector<std::remove_cvref_t<decltype(*pipeline.begin())>> out;
+		for (auto x : pipeline) out.push_back(x);
+		return out;
+	};
+	auto check = [&](const auto& values, auto pred)
+	{
+		EXPECT_EQ(Range::from(values) > filter(pred) > to_vector(), pulled(Range::from(values) > filter(pred)));
+	};
+
+	std::vector<int> ints{ 0, 1, 2, 3, 4, 5 };
+	EXPECT_EQ(Range::from(ints) > filter(lt(2.5)) > to_vector(), (std::vector{ 0, 1, 2 }));
+	EXPECT_EQ(Range::from(ints) > filter(eq(2.5)) > sum(), 0);
+	EXPECT_EQ(Range::from(ints) > filter(ge(2.5)) > sum(), 12);
+	EXPECT_EQ(Range::from(ints) > filter(lt(5'000'000'000LL)) > count(), 6);
+	EXPECT_EQ(Range::from(ints) > filter(lt(5'000'000'000LL)) > sum(), 15);
+	check(ints, lt(2.5));
+	check(ints, le(-0.5));
+	check(ints, gt(1e30));
+	check(ints, ne(3.25));
+	check(ints, between(0.5, 3.5));
+	check(ints, gt(-5'000'000'000LL));
+	check(ints, lt(short{ 3 }));
+	check(ints, lt(std::numeric_limits<double>::quiet_NaN()));
+
+	std::vector<float> floats{ 0.0f, 0.1f, 0.2f, 0.3f };
+	check(floats, eq(0.1));
+	check(floats, le(0.1));
+	check(floats, gt(0.2));
+
+	std::vector<long long> wide{ (1LL << 53), (1LL << 53) + 1, (1LL << 53) + 2 };
+	check(wide, eq(9007199254740992.0));
+	check(wide, gt(9007199254740992.0));
+};
+TEST(DataPipeline, GroupBy) {
+	using namespace uutils::data_processing;
+
+	auto counts = range(0, 1000) > group_by([](int x) { return x % 7; }, agg::count());
+	EXPECT_EQ(counts.size(), 7);
+	EXPECT_EQ(counts.at(0), 143);
+	EXPECT_EQ(counts.at(6), 142);
+
+	struct Row { std::string host; long long bytes; };
+	std::vector<Row> rows{ { "a", 10 }, { "b", 5 }, { "a", 7 }, { "c", 1 }, { "b", 20 } };
+
+	auto bytes = Range::from(rows) > group_by(&Row::host, agg::sum(&Row::bytes));
+	EXPECT_EQ(bytes.at("a"), 17);
+	EXPECT_EQ(bytes.at("b"), 25);
+	EXPECT_EQ(bytes.at("c"), 1);
+
+	auto smallest = Range::from(rows) > group_by(&Row::host, agg::min(&Row::bytes));
+	auto largest = Range::from(rows) > group_by(&Row::host, agg::max(&Row::bytes));
+	EXPECT_EQ(smallest.at("b"), 5);
+	EXPECT_EQ(largest.at("b"), 20);
+
+	auto joined = Range::from(rows) > group_by(&Row::host, agg::fold(std::string(), [](std::string acc, const Row& row) { return acc + std::to_string(row.bytes) + ";"; }));
+	EXPECT_EQ(joined.at("a"), "10;7;");
+
+	// The first accumulator of a group is only built for a new key
+	int folds = 0;
+	auto counted = Range::from(rows) > group_by(&Row::host, agg::fold(0LL, [&folds](long long acc, const Row& row) { folds++; return acc + row.bytes; }));
+	EXPECT_EQ(counted.at("b"), 25);
+	EXPECT_EQ(folds, 5);
+};
+
+TEST(DataPipeline, GroupBy_Parallel) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data(100000);
+	for (std::size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<int>(i * 7919 % 100003);
+
+	auto key = [](int x) { return x % 1000; };
+	auto serial = Range::from(data) > group_by(key, agg::sum());
+	auto parallel = Range::from(data) > group_by(par, key, agg::sum());
+	ASSERT_EQ(parallel.size(), serial.size());
+	for (const auto& [k, v] : serial)
+		EXPECT_EQ(parallel.at(k), v);
+
+	auto counts = Range::from(data) > group_by(uutils::data_processing::parallel(4), key, agg::count());
+	std::size_t total = 0;
+	for (const auto& [k, v] : counts)
+		total += v;
+	EXPECT_EQ(total, data.size());
+
+	auto folded = Range::from(data) > group_by(par, key,
+		agg::fold(0LL, [](long long acc, int x) { return acc + x; }, [](long long a, long long b) { return a + b; }));
+	for (const auto& [k, v] : serial)
+		EXPECT_EQ(folded.at(k), v);
+};
+
+TEST(DataPipeline, TopK) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data{ 5, 1, 9, 3, 7, 9, 2, 8 };
+
+	auto top = Range::from(data) > top_k<3>();
+	static_assert(std::is_same_v<decltype(top), uutils::StaticVector<int, 3>>);
+	ASSERT_EQ(top.size(), 3);
+	EXPECT_EQ(top[0], 9);
+	EXPECT_EQ(top[1], 9);
+	EXPECT_EQ(top[2], 8);
+
+	auto bottom = Range::from(data) > bottom_k<2>();
+	ASSERT_EQ(bottom.size(), 2);
+	EXPECT_EQ(bottom[0], 1);
+	EXPECT_EQ(bottom[1], 2);
+
+	auto few = range(0, 2) > top_k<5>();
+	ASSERT_EQ(few.size(), 2);
+	EXPECT_EQ(few[0], 1);
+
+	EXPECT_EQ(Range::from(data) > top_k(4), (std::vector<int>{ 9, 9, 8, 7 }));
+	EXPECT_EQ(Range::from(data) > bottom_k(3), (std::vector<int>{ 1, 2, 3 }));
+	EXPECT_TRUE((Range::from(data) > top_k(0)).empty());
+
+	struct Request { std::string path; double latency; };
+	std::vector<Request> requests{ { "/a", 0.5 }, { "/b", 2.0 }, { "/c", 1.0 } };
+	auto slowest = Range::from(requests) > top_k<2>([](const Request& a, const Request& b) { return a.latency < b.latency; });
+	EXPECT_EQ(slowest[0].path, "/b");
+	EXPECT_EQ(slowest[1].path, "/c");
+};
+
+TEST(DataPipeline, Sorted) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> small{ 3, -1, 2 };
+	EXPECT_EQ(Range::from(small) > sorted(), (std::vector<int>{ -1, 2, 3 }));
+	EXPECT_EQ(Range::from(small) > sorted_by(std::greater<>()), (std::vector<int>{ 3, 2, -1 }));
+
+	// Large enough for the radix path, with negative numbers and the extremes
+	std::vector<long long> data(5000);
+	for (std::size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<long long>(i * 2654435761u % 10007) - 5000;
+	data[10] = std::numeric_limits<long long>::min();
+	data[20] = std::numeric_limits<long long>::max();
+
+	auto expected = data;
+	std::sort(expected.begin(), expected.end());
+	EXPECT_EQ(Range::from(data) > sorted(), expected);
+
+	std::vector<std::string> words{ "pear", "fig", "apple" };
+	EXPECT_EQ(Range::from(words) > sorted(), (std::vector<std::string>{ "apple", "fig", "pear" }));
+
+	// Sorting by an integer key is stable, below the radix threshold too
+	struct Item { int key; int order; };
+	for (int size : { 10, 200, 1000 })
+	{
+		std::vector<Item> items(size);
+		for (int i = 0; i < size; i++)
+			items[i] = { (i * 37) % 10, i };
+		auto by_key = Range::from(items) > sorted_by_key(&Item::key);
+		for (std::size_t i = 1; i < by_key.size(); i++)
+		{
+			ASSERT_LE(by_key[i - 1].key, by_key[i].key);
+			if (by_key[i - 1].key == by_key[i].key)
+			{
+				ASSERT_LT(by_key[i - 1].order, by_key[i].order) << size;
+			}
+		}
+	}
+};
+
+TEST(DataPipeline, Zip) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> ids{ 1, 2, 3, 4 };
+	std::vector<std::string> names{ "a", "b", "c" };
+
+	auto zipped = Range::from(ids) > zip(Range::from(names));
+	EXPECT_EQ(zipped.size(), 3);
+	auto end = zipped.end();
+	EXPECT_EQ(end - zipped.begin(), 3);
+	EXPECT_EQ(zipped.begin()[2], std::make_pair(3, std::string("c")));
+
+	auto pairs = zipped > to_vector();
+	ASSERT_EQ(pairs.size(), 3);
+	EXPECT_EQ(pairs[1].first, 2);
+	EXPECT_EQ(pairs[1].second, "b");
+
+	// Pull through a non-random-access side, stopping at the shorter one
+	auto evens = range(0, 100) > filter([](int x) { return x % 2 == 0; });
+	std::vector<std::pair<int, int>> pulled;
+	for (auto pair : Range::from(ids) > zip(evens))
+		pulled.push_back(pair);
+	EXPECT_EQ(pulled, (std::vector<std::pair<int, int>>{ { 1, 0 }, { 2, 2 }, { 3, 4 }, { 4, 6 } }));
+
+	auto dot = Range::from(ids) > zip(range(10, 4)) > map([](auto p) { return p.first * p.second; }) > sum();
+	EXPECT_EQ(dot, 10 + 22 + 36 + 52);
+
+	std::vector<double> a(50000, 2.0), b(50000, 3.0);
+	auto products = Range::from(a) > zip(Range::from(b)) > map([](auto p) { return p.first * p.second; });
+	EXPECT_EQ(products > to_vector(par), products > to_vector());
+};
+
+TEST(DataPipeline, HashJoin) {
+	using namespace uutils::data_processing;
+
+	struct Event { int user; int value; };
+	struct User { int id; std::string name; };
+	std::vector<Event> events{ { 1, 10 }, { 2, 20 }, { 3, 30 }, { 1, 40 }, { 9, 90 } };
+	std::vector<User> users{ { 1, "ann" }, { 2, "bob" }, { 3, "cy" }, { 1, "ann2" } };
+
+	auto joined = Range::from(events) > hash_join(Range::from(users), &Event::user, &User::id);
+	std::vector<std::pair<int, std::string>> pushed;
+	joined > for_each_batch([&](auto batch) { for (const auto& [e, u] : batch) pushed.emplace_back(e.value, u.name); });
+	std::vector<std::pair<int, std::string>> pulled;
+	for (const auto& [e, u] : joined)
+		pulled.emplace_back(e.value, u.name);
+
+	// Users is the smaller side, so events stream in order and matches keep the order of users
+	std::vector<std::pair<int, std::string>> expected{ { 10, "ann" }, { 10, "ann2" }, { 20, "bob" }, { 30, "cy" }, { 40, "ann" }, { 40, "ann2" } };
+	EXPECT_EQ(pushed, expected);
+	EXPECT_EQ(pulled, expected);
+
+	// Left side smaller: the table is built on it, pairs still come out as (left, right)
+	std::vector<int> wanted{ 2, 3 };
+	auto values = Range::from(wanted) > hash_join(Range::from(events), [](int x) { return x; }, &Event::user)
+		> map([](const auto& p) { return p.second.value; }) > to_vector();
+	EXPECT_EQ(values, (std::vector<int>{ 20, 30 }));
+
+	// Unsized left side, keys of different integer types, pulled through a filter
+	auto odd_users = range(0, 10) > filter([](int x) { return x % 2 == 1; });
+	auto names = odd_users > hash_join(Range::from(users), [](int x) { return static_cast<long long>(x); }, &User::id)
+		> map([](const auto& p) { return p.second.name; }) > to_vector();
+	EXPECT_EQ(names, (std::vector<std::string>{ "ann", "ann2", "cy" }));
+
+	std::vector<int> big(100000);
+	for (std::size_t i = 0; i < big.size(); i++)
+		big[i] = static_cast<int>(i % 7);
+	auto matches = Range::from(big) > hash_join(Range::from(wanted), [](int x) { return x; }, [](int x) { return x; })
+		> map([](const auto& p) { return p.first; });
+	EXPECT_EQ(matches > sum(par), matches > sum());
+	EXPECT_EQ(matches > count(), 2 * 14286);
+};
+
+TEST(DataPipeline, Inspect) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> seen;
+	auto doubled = range(0, 5) > inspect([&](int x) { seen.push_back(x); }) > map([](int x) { return x * 2; }) > to_vector();
+	EXPECT_EQ(doubled, (std::vector<int>{ 0, 2, 4, 6, 8 }));
+	EXPECT_EQ(seen, (std::vector<int>{ 0, 1, 2, 3, 4 }));
+
+	// Lvalues pass through by reference
+	std::vector<std::string> words{ "a", "b" };
+	auto inspected = Range::from(words) > inspect([](const std::string&) {});
+	EXPECT_EQ(&*inspected.begin(), &words[0]);
+	EXPECT_EQ(inspected.size(), 2);
+};
+
+TEST(DataPipeline, Profile) {
+	using namespace uutils::data_processing;
+
+	auto square = [](int x) { return x * x; };
+	auto odd = [](int x) { return x % 2 == 1; };
+
+	// Switched off, the stages are exactly what they would be without profile()
+	static_assert(std::is_same_v<decltype(profile(no_profile, "square", map(square))), decltype(map(square))>);
+	auto plain = range(0, 100) > profile(no_profile, "square", map(square)) > profile(no_profile, "odd", filter(odd)) > sum();
+
+	std::vector<int> data(1000);
+	std::iota(data.begin(), data.end(), 0);
+
+	Profile pushed;
+	auto total = Range::from(data) > profile(pushed, "square", map(square)) > profile(pushed, "odd", filter(odd))
+		> profile(pushed, "first 100", take(100)) > sum();
+	EXPECT_EQ(total, Range::from(data) > map(square) > filter(odd) > take(100) > sum());
+
+	auto report = pushed.report();
+	ASSERT_EQ(report.size(), 3);
+	EXPECT_EQ(report[0].name, "square");
+	// take stops the source after the 100th odd square, which is the one of 199
+	EXPECT_EQ(report[0].in, 200);
+	EXPECT_EQ(report[0].out, 200);
+	EXPECT_EQ(report[1].name, "odd");
+	EXPECT_EQ(report[1].in, 200);
+	EXPECT_EQ(report[1].out, 100);
+	EXPECT_EQ(report[2].in, 100);
+	EXPECT_EQ(report[2].out, 100);
+	EXPECT_DOUBLE_EQ(report[1].selectivity(), 0.5);
+	EXPECT_EQ(plain, range(0, 100) > map(square) > filter(odd) > sum());
+
+	Profile pulled;
+	auto pipeline = Range::from(data) > profile(pulled, "odd", filter(odd));
+	int count = 0;
+	for (auto it = pipeline.begin(); it != pipeline.end(); ++it) count++;
+	EXPECT_EQ(count, 500);
+	EXPECT_EQ(pulled.report()[0].in, 1000);
+	EXPECT_EQ(pulled.report()[0].out, 500);
+
+	Profile parallel;
+	auto counted = Range::from(data) > profile(parallel, "square", map(square)) > sum(par);
+	EXPECT_EQ(counted, Range::from(data) > map(square) > sum());
+	EXPECT_EQ(parallel.report()[0].in, 1000);
+
+	std::ostringstream out;
+	pushed.print(out);
+	EXPECT_NE(out.str().find("first 100"), std::string::npos);
+};
+
+TEST(DataPipeline, ClosedForm) {
+	using namespace uutils::data_processing;
+
+	// Far too many steps for a constant-evaluated loop
+	static_assert((range(0LL, 1'000'000'000LL) > sum()) == 499'999'999'500'000'000LL);
+	static_assert((range(-5, 1'000'000'000) > max()) == 999'999'994);
+
+	// map hides the interval, so these take the general path
+	auto walked = [](auto&& pipeline) { return pipeline > map([](auto x) { return x; }); };
+	auto check = [&](auto&& pipeline)
+	{
+		EXPECT_EQ(pipeline > sum(), walked(pipeline) > sum());
+		EXPECT_EQ(pipeline > sum(par), walked(pipeline) > sum());
+		EXPECT_EQ(pipeline > count(), walked(pipeline) > count());
+		for (int bound : { -100, -7, 0, 3, 50, 96, 97, 1000 })
+		{
+			EXPECT_EQ(pipeline > count(lt(bound)), walked(pipeline) > count(lt(bound)));
+			EXPECT_EQ(pipeline > count(le(bound)), walked(pipeline) > count(le(bound)));
+			EXPECT_EQ(pipeline > count(gt(bound)), walked(pipeline) > count(gt(bound)));
+			EXPECT_EQ(pipeline > count(ge(bound)), walked(pipeline) > count(ge(bound)));
+			EXPECT_EQ(pipeline > count(eq(bound)), walked(pipeline) > count(eq(bound)));
+			EXPECT_EQ(pipeline > count(ne(bound)), walked(pipeline) > count(ne(bound)));
+			EXPECT_EQ(pipeline > count(between(bound, bound + 20)), walked(pipeline) > count(between(bound, bound + 20)));
+			EXPECT_EQ(pipeline > any(gt(bound)), walked(pipeline) > any(gt(bound)));
+			EXPECT_EQ(pipeline > all(gt(bound)), walked(pipeline) > all(gt(bound)));
+			EXPECT_EQ(pipeline > none(gt(bound)), walked(pipeline) > none(gt(bound)));
+			EXPECT_EQ(pipeline > all(par, lt(bound)), walked(pipeline) > all(lt(bound)));
+		}
+		if ((pipeline > count()) != 0)
+		{
+			EXPECT_EQ(pipeline > min(), walked(pipeline) > min());
+			EXPECT_EQ(pipeline > max(), walked(pipeline) > max());
+			EXPECT_EQ(pipeline > minmax(), walked(pipeline) > minmax());
+		}
+		else
+			EXPECT_THROW(pipeline > max(), std::out_of_range);
+	};
+
+	check(range(-20, 117));
+	check(range(-20, 117) > skip(10) > take(50));
+	check(range(-20, 117) > reverse() > take(30));
+	check(range(-20, 117) > take(5) > reverse() > skip(2));
+	check(range(3, 0));
+	check(range(3, 10) > skip(20));
+
+	// Fractional bounds are compared like the general path does
+	EXPECT_EQ(range(0, 10) > count(lt(4.5)), 5);
+	EXPECT_EQ(range(0, 10) > count(between(2.5, 6.5)), 4);
+
+	// Same wrap-around as the loop for narrow types
+	EXPECT_EQ(range<std::int8_t>(100, 20) > sum(), walked(range<std::int8_t>(100, 20)) > sum());
+
+	// Empty sized ranges answer without calling the predicate
+	std::vector<int> empty;
+	auto never = [](int) -> bool { throw std::logic_error("called"); };
+	EXPECT_TRUE(Range::from(empty) > all(never));
+	EXPECT_FALSE(Range::from(empty) > any(never));
+	EXPECT_TRUE(Range::from(empty) > none(never));
+};
+
+TEST(DataPipeline, IteratorSize) {
+	using namespace uutils::data_processing;
+	std::vector<int> data = { 1, 2, 3 };
+
+	// Stateless stages add nothing to the iterator
+	auto maps = Range::from(data) > map([](int x) { return x + 1; }) > map([](int x) { return x * 2; }) > map([](int x) { return x - 3; });
+	static_assert(sizeof(detail::iterator_t<decltype(maps)>) == sizeof(std::vector<int>::const_iterator));
+
+	// Stateful ones are reached through the stage instead of being copied
+	std::array<int, 64> table{};
+	auto lookup = Range::from(data) > map([table](int x) { return table[x]; });
+	static_assert(sizeof(detail::iterator_t<decltype(lookup)>) == 2 * sizeof(void*));
+
+	auto odd = Range::from(data) > filter([](int x) { return x % 2 == 1; });
+	static_assert(sizeof(detail::iterator_t<decltype(odd)>) == 2 * sizeof(std::vector<int>::const_iterator));
+
+	EXPECT_EQ(maps > to_vector(), std::vector<int>({ 1, 3, 5 }));
+	EXPECT_EQ(lookup > sum(), 0);
+	EXPECT_EQ(odd > to_vector(), std::vector<int>({ 1, 3 }));
+};
+
+TEST(DataPipeline, MoveOnlyFunctors) {
+	using namespace uutils::data_processing;
+	std::vector<int> data = { 1, 2, 3, 4, 5 };
+
+	auto scaled = Range::from(data) > map([factor = std::make_unique<int>(10)](int x) { return x * *factor; })
+		> filter([limit = std::make_unique<int>(30)](int x) { return x < *limit; });
+	EXPECT_EQ(scaled > to_vector(), std::vector<int>({ 10, 20 }));
+
+	std::vector<int> pulled;
+	for (int x : scaled) pulled.push_back(x);
+	EXPECT_EQ(pulled, std::vector<int>({ 10, 20 }));
+
+	int seen = 0;
+	auto counted = Range::from(data) > inspect([counter = std::make_unique<int*>(&seen)](int) { ++**counter; });
+	EXPECT_EQ(counted > sum(), 15);
+	EXPECT_EQ(seen, 5);
+
+	auto batched = Range::from(data) > map_batch<int>([offset = std::make_unique<int>(100)](std::span<const int> in, std::span<int> out)
+	{
+		for (std::size_t i = 0; i < in.size(); i++) out[i] = in[i] + *offset;
+	}, 2);
+	EXPECT_EQ(batched > to_vector(), std::vector<int>({ 101, 102, 103, 104, 105 }));
+	std::vector<int> batched_pulled;
+	for (int x : batched) batched_pulled.push_back(x);
+	EXPECT_EQ(batched_pulled, std::vector<int>({ 101, 102, 103, 104, 105 }));
+};
+
+template <class C>
+concept FromAccepts = requires(C&& c) { uutils::data_processing::Range::from(std::forward<C>(c)); };
+
+TEST(DataPipeline, Range_Own) {
+	using namespace uutils::data_processing;
+
+	std::vector<std::unique_ptr<int>> boxes;
+	for (int i = 1; i <= 4; i++) boxes.push_back(std::make_unique<int>(i));
+	auto owned = Range::own(std::move(boxes));
+	EXPECT_EQ(owned.size(), 4u);
+	EXPECT_EQ(owned > map([](const auto& box) { return *box; }) > sum(), 10);
+
+	auto make = []
+	{
+		std::vector<int> local = { 5, 6, 7, 8 };
+		return Range::own(std::move(local)) > filter([](int x) { return x % 2 == 0; }) > map([](int x) { return x * 10; });
+	};
+	auto pipeline = make();
+	EXPECT_EQ(pipeline > to_vector(), std::vector<int>({ 60, 80 }));
+	EXPECT_EQ(pipeline > sum(parallel(2)), 140);
+
+	// from() rejects temporary containers, which own needs to keep alive, but takes views
+	static_assert(FromAccepts<std::vector<int>&>);
+	static_assert(FromAccepts<const std::vector<int>&>);
+	static_assert(!FromAccepts<std::vector<int>>);
+	static_assert(FromAccepts<std::string_view>);
+	static_assert(FromAccepts<std::span<const int>>);
+	EXPECT_EQ(Range::from(std::string_view("abc")) > count(), 3);
+};
+
+TEST(DataPipeline, FromMut) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data = { 5, -3, 12, 7, 40, 0 };
+	static_assert(detail::MutableRange<decltype(Range::from_mut(data))>);
+	static_assert(!detail::MutableRange<decltype(Range::from(data))>);
+
+	Range::from_mut(data) > transform_inplace([](int x) { return std::clamp(x, 0, 10); });
+	EXPECT_EQ(data, std::vector<int>({ 5, 0, 10, 7, 10, 0 }));
+
+	// Writes reach the source through filters, skips and takes, including SIMD compare filters
+	Range::from_mut(data) > filter(gt(6)) > transform_inplace([](int x) { return x * 100; });
+	EXPECT_EQ(data, std::vector<int>({ 5, 0, 1000, 700, 1000, 0 }));
+	Range::from_mut(data) > skip(1) > take(2) > for_each([](int& x) { x = -x; });
+	EXPECT_EQ(data, std::vector<int>({ 5, 0, -1000, 700, 1000, 0 }));
+
+	std::list<std::string> words = { "a", "bb", "ccc" };
+	Range::from_mut(words) > filter([](const std::string& w) { return w.size() > 1; }) > for_each([](std::string& w) { w += "!"; });
+	EXPECT_EQ(words, std::list<std::string>({ "a", "bb!", "ccc!" }));
+
+	// Read-only ranges only get looked at
+	int total = 0;
+	Range::from(data) > map([](int x) { return x / 100; }) > for_each([&total](int x) { total += x; });
+	EXPECT_EQ(total, 7);
+
+	std::vector<double> samples(100'000);
+	std::iota(samples.begin(), samples.end(), 0.0);
+	Range::from_mut(samples) > transform_inplace(parallel(4), [](double x) { return x / 2; });
+	EXPECT_EQ(samples[99'999], 49'999.5);
+	EXPECT_EQ(Range::from(samples) > sum(), 99'999.0 * 100'000 / 4);
+
+	std::vector<std::atomic<int>> hits(50'000);
+	Range::from_mut(hits) > for_each(par, [](std::atomic<int>& hit) { hit++; });
+	EXPECT_TRUE(Range::from(hits) > all([](const std::atomic<int>& hit) { return hit == 1; }));
+};
+
+TEST(DataPipeline, Window) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data = { 1, 2, 3, 4, 5 };
+	std::vector<std::vector<int>> windows;
+	for (auto w : Range::from(data) > window(3)) windows.emplace_back(w.begin(), w.end());
+	EXPECT_EQ(windows, (std::vector<std::vector<int>>{ { 1, 2, 3 }, { 2, 3, 4 }, { 3, 4, 5 } }));
+	EXPECT_EQ((Range::from(data) > window(3)).size(), 3u);
+	EXPECT_EQ((Range::from(data) > window(3) > to_vector())[1].data(), data.data() + 1);
+	EXPECT_EQ(Range::from(data) > window(6) > count(), 0u);
+	EXPECT_EQ(Range::from(data) > window(1) > count(), 5u);
+
+	std::vector<int> big(100'000);
+	std::iota(big.begin(), big.end(), 0);
+	auto first = [](std::span<const int> w) { return w.front(); };
+	EXPECT_EQ(Range::from(big) > window(64) > map(first) > to_vector(par), Range::from(big) > window(64) > map(first) > to_vector());
+};
+
+TEST(DataPipeline, Rolling) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data;
+	unsigned state = 7;
+	for (int i = 0; i < 2000; i++)
+	{
+		state = state * 1103515245u + 12345u;
+		data.push_back(static_cast<int>(state >> 16) % 50 - 25);
+	}
+
+	for (std::size_t w : { 1u, 2u, 7u, 64u, 2000u, 2001u })
+	{
+		std::vector<long long> sums;
+		std::vector<double> means;
+		std::vector<int> mins, maxs;
+		for (std::size_t i = 0; i + w <= data.size(); i++)
+		{
+			auto first = data.begin() + static_cast<std::ptrdiff_t>(i), last = first + static_cast<std::ptrdiff_t>(w);
+			sums.push_back(std::accumulate(first, last, 0LL));
+			means.push_back(static_cast<double>(sums.back()) / static_cast<double>(w));
+			mins.push_back(*std::min_element(first, last));
+			maxs.push_back(*std::max_element(first, last));
+		}
+
+		auto wide = Range::from(data) > map([](int x) { return static_cast<long long>(x); });
+		EXPECT_EQ(wide > rolling_sum(w) > to_vector(), sums);
+		EXPECT_EQ(Range::from(data) > rolling_mean(w) > to_vector(), means);
+		EXPECT_EQ(Range::from(data) > rolling_min(w) > to_vector(), mins);
+		EXPECT_EQ(Range::from(data) > rolling_max(w) > to_vector(), maxs);
+		EXPECT_EQ((Range::from(data) > rolling_max(w)).size(), maxs.size());
+
+		// Pulled, in parallel slices, and behind a stage that is neither sized nor splittable
+		std::vector<int> pulled;
+		for (int x : Range::from(data) > rolling_min(w)) pulled.push_back(x);
+		EXPECT_EQ(pulled, mins);
+		EXPECT_EQ(Range::from(data) > rolling_max(w) > to_vector(par), maxs);
+		EXPECT_EQ(Range::from(data) > filter([](int) { return true; }) > rolling_min(w) > to_vector(), mins);
+	}
+
+	EXPECT_EQ(Range::from(data) > rolling_max<16>() > to_vector(), Range::from(data) > rolling_max(16) > to_vector());
+	EXPECT_EQ(Range::from(data) > rolling_sum<5>() > to_vector(), Range::from(data) > rolling_sum(5) > to_vector());
+	EXPECT_EQ(range(1, 5) > rolling_mean<2>() > to_vector(), std::vector<double>({ 1.5, 2.5, 3.5, 4.5 }));
+};
+
+TEST(DataPipeline, Scan) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> data = { 3, 1, 4, 1, 5 };
+	auto plus = [](long long a, int b) { return a + b; };
+	EXPECT_EQ(Range::from(data) > scan(plus, 10LL) > to_vector(), std::vector<long long>({ 13, 14, 18, 19, 24 }));
+	EXPECT_EQ(Range::from(data) > scan(exclusive, plus, 10LL) > to_vector(), std::vector<long long>({ 10, 13, 14, 18, 19 }));
+	EXPECT_EQ((Range::from(data) > scan(plus, 0LL)).size(), 5u);
+
+	// Pulled, also behind a stage that ends in a sentinel, and stopped early
+	std::vector<int> running_max;
+	for (int x : Range::from(data) > scan([](int a, int b) { return std::max(a, b); }, 0)) running_max.push_back(x);
+	EXPECT_EQ(running_max, std::vector<int>({ 3, 3, 4, 4, 5 }));
+	std::vector<long long> pulled;
+	for (long long x : Range::from(data) > filter([](int x) { return x > 1; }) > take(10) > scan(exclusive, plus, 0LL)) pulled.push_back(x);
+	EXPECT_EQ(pulled, std::vector<long long>({ 0, 3, 7 }));
+	EXPECT_EQ(Range::from(data) > scan(plus, 0LL) > take(2) > to_vector(), std::vector<long long>({ 3, 4 }));
+
+	std::vector<std::string> words = { "a", "b", "c" };
+	EXPECT_EQ(Range::from(words) > scan(std::plus<>(), std::string()) > to_vector(), std::vector<std::string>({ "a", "ab", "abc" }));
+
+	EXPECT_TRUE((Range::own(std::vector<int>()) > scan(plus, 0LL) > to_vector()).empty());
+};
+
+TEST(DataPipeline, PrefixSums) {
+	using namespace uutils::data_processing;
+
+	std::vector<int> lengths = { 3, 1, 4, 1, 5 };
+	EXPECT_EQ(Range::from(lengths) > to_prefix_sums(), std::vector<int>({ 3, 4, 8, 9, 14 }));
+	EXPECT_EQ(Range::from(lengths) > to_prefix_sums(exclusive), std::vector<int>({ 0, 3, 4, 8, 9 }));
+	EXPECT_EQ(Range::from(lengths) > filter([](int x) { return x > 1; }) > to_prefix_sums(exclusive), std::vector<int>({ 0, 3, 7 }));
+	EXPECT_TRUE((Range::own(std::vector<int>()) > to_prefix_sums(exclusive)).empty());
+
+	for (std::size_t size : { 1'000u, 100'003u })
+	{
+		std::vector<long long> data(size);
+		for (std::size_t i = 0; i < size; i++) data[i] = static_cast<long long>(i * 7919 % 1000) - 500;
+		std::vector<long long> inclusive(size), exclusive_sums(size);
+		std::inclusive_scan(data.begin(), data.end(), inclusive.begin());
+		std::exclusive_scan(data.begin(), data.end(), exclusive_sums.begin(), 0LL);
+
+		EXPECT_EQ(Range::from(data) > to_prefix_sums(), inclusive);
+		EXPECT_EQ(Range::from(data) > to_prefix_sums(parallel(4)), inclusive);
+		EXPECT_EQ(Range::from(data) > to_prefix_sums(parallel(4), exclusive), exclusive_sums);
+		EXPECT_EQ(Range::from(data) > scan(std::plus<>(), 0LL) > to_vector(), inclusive);
+
+		// Mapped and skipped sources still go through blocks
+		std::vector<long long> doubled(size - 1);
+		std::transform(data.begin() + 1, data.end(), doubled.begin(), [](long long x) { return 2 * x; });
+		std::inclusive_scan(doubled.begin(), doubled.end(), doubled.begin());
+		EXPECT_EQ(Range::from(data) > skip(1) > map([](long long x) { return 2 * x; }) > to_prefix_sums(par), doubled);
+	}
+
+	EXPECT_EQ(range(1, 100'000) > to_prefix_sums(par), range(1, 100'000) > scan(std::plus<>(), 0) > to_vector());
+};
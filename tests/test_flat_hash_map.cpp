@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <string>
+
+#include <uutils/flat_hash_map.h>
+
+TEST(FlatHashMap, InsertFind) {
+	uutils::FlatHashMap<int, std::string> map;
+
+	EXPECT_TRUE(map.empty());
+	EXPECT_EQ(map.find(1), map.end());
+
+	auto [it, inserted] = map.try_emplace(1, "one");
+	EXPECT_TRUE(inserted);
+	EXPECT_EQ(it->second, "one");
+	EXPECT_FALSE(map.try_emplace(1, "uno").second);
+	EXPECT_EQ(map.at(1), "one");
+
+	map[2] = "two";
+	map.insert_or_assign(1, "uno");
+	EXPECT_EQ(map.size(), 2);
+	EXPECT_EQ(map.at(1), "uno");
+	EXPECT_TRUE(map.contains(2));
+	EXPECT_FALSE(map.contains(3));
+	EXPECT_THROW(map.at(3), std::out_of_range);
+}
+
+TEST(FlatHashMap, Reserve) {
+	uutils::FlatHashMap<int, int> map(1000);
+	auto capacity = map.capacity();
+
+	EXPECT_GE(capacity, 1000);
+	for (int i = 0; i < 1000; i++)
+		map[i] = i;
+	EXPECT_EQ(map.capacity(), capacity);
+}
+
+TEST(FlatHashMap, GrowAndIterate) {
+	uutils::FlatHashMap<std::string, int> map;
+	for (int i = 0; i < 10000; i++)
+		map[std::to_string(i)] += i;
+
+	EXPECT_EQ(map.size(), 10000);
+	long long sum = 0;
+	std::size_t count = 0;
+	for (const auto& [key, value] : map)
+	{
+		EXPECT_EQ(std::stoi(key), value);
+		sum += value;
+		count++;
+	}
+	EXPECT_EQ(count, 10000);
+	EXPECT_EQ(sum, 9999LL * 10000 / 2);
+}
+
+TEST(FlatHashMap, EraseMatchesStdMap) {
+	uutils::FlatHashMap<int, int> map;
+	std::map<int, int> expected;
+	std::mt19937 rng(42);
+
+	for (int i = 0; i < 20000; i++)
+	{
+		int key = static_cast<int>(rng() % 512);
+		if (rng() % 3 == 0)
+			EXPECT_EQ(map.erase(key), expected.erase(key));
+		else
+		{
+			map[key] = i;
+			expected[key] = i;
+		}
+	}
+
+	ASSERT_EQ(map.size(), expected.size());
+	for (const auto& [key, value] : expected)
+		EXPECT_EQ(map.at(key), value);
+}
+
+TEST(FlatHashMap, CopyMove) {
+	uutils::FlatHashMap<int, std::string> map;
+	for (int i = 0; i < 100; i++)
+		map[i] = std::to_string(i);
+
+	auto copy = map;
+	EXPECT_EQ(copy.size(), 100);
+	EXPECT_EQ(copy.at(42), "42");
+
+	auto moved = std::move(map);
+	EXPECT_EQ(moved.size(), 100);
+	EXPECT_TRUE(map.empty());
+	EXPECT_FALSE(map.contains(42));
+
+	map = moved;
+	EXPECT_EQ(map.at(99), "99");
+	map.clear();
+	EXPECT_TRUE(map.empty());
+	EXPECT_EQ(map.begin(), map.end());
+}
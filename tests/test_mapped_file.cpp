@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#include <uutils/mapped_file.h>
+
+namespace
+{
+	std::filesystem::path write_file(const char* name, const std::string& contents)
+	{
+		auto path = std::filesystem::temp_directory_path() / name;
+		std::ofstream(path, std::ios::binary) << contents;
+		return path;
+	}
+}
+
+TEST(MappedFile, MapsContents) {
+	auto path = write_file("uutils_test_mapped_file.txt", "hello mapped file");
+
+	uutils::MappedFile file(path);
+	EXPECT_EQ(file.size(), 17);
+	EXPECT_EQ(std::memcmp(file.data(), "hello mapped file", 17), 0);
+
+	file.advise(uutils::MappedFile::Advice::Random);
+	file.prefetch(4, 100);
+
+	uutils::MappedFile moved = std::move(file);
+	EXPECT_EQ(moved.size(), 17);
+	EXPECT_EQ(file.data(), nullptr);
+
+	std::filesystem::remove(path);
+}
+
+TEST(MappedFile, EmptyFile) {
+	auto path = write_file("uutils_test_mapped_file_empty.txt", "");
+
+	uutils::MappedFile file(path);
+	EXPECT_EQ(file.size(), 0);
+	EXPECT_EQ(file.data(), nullptr);
+
+	std::filesystem::remove(path);
+}
+
+TEST(MappedFile, MissingFile) {
+	EXPECT_THROW(uutils::MappedFile("/nonexistent/uutils_test_mapped_file"), std::system_error);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <uutils/simd.h>
+
+template <class T>
+static std::vector<T> make_data(std::size_t size)
+{
+	std::vector<T> data(size);
+	for (std::size_t i = 0; i < size; i++)
+		data[i] = static_cast<T>(static_cast<int>(i * 7919 % 1000) - 500);
+	return data;
+}
+
+template <class T>
+static void check_kernels()
+{
+	for (std::size_t size : { 1, 2, 3, 7, 8, 9, 16, 31, 32, 33, 63, 64, 65, 1001 })
+	{
+		auto data = make_data<T>(size);
+
+		EXPECT_EQ(uutils::simd::sum(data.data(), size), std::accumulate(data.begin(), data.end(), T(0))) << size;
+		EXPECT_EQ(uutils::simd::min(data.data(), size), *std::min_element(data.begin(), data.end())) << size;
+		EXPECT_EQ(uutils::simd::max(data.data(), size), *std::max_element(data.begin(), data.end())) << size;
+
+		auto [lo, hi] = uutils::simd::minmax(data.data(), size);
+		EXPECT_EQ(lo, *std::min_element(data.begin(), data.end())) << size;
+		EXPECT_EQ(hi, *std::max_element(data.begin(), data.end())) << size;
+
+		std::vector<T> expected(size), sums(size);
+		std::inclusive_scan(data.begin(), data.end(), expected.begin(), std::plus<>(), T(3));
+		EXPECT_EQ(uutils::simd::prefix_sum(data.data(), sums.data(), size, T(3)), expected.back()) << size;
+		EXPECT_EQ(sums, expected) << size;
+		uutils::simd::prefix_sum(data.data(), data.data(), size, T(3));
+		EXPECT_EQ(data, expected) << size;
+	}
+}
+
+TEST(Simd, Int32) { check_kernels<std::int32_t>(); }
+TEST(Simd, Int64) { check_kernels<std::int64_t>(); }
+TEST(Simd, Float) { check_kernels<float>(); }
+TEST(Simd, Double) { check_kernels<double>(); }
+TEST(Simd, ScalarFallback) {
+	check_kernels<std::int16_t>();
+	check_kernels<std::uint16_t>();
+	check_kernels<std::int8_t>();
+	check_kernels<std::uint32_t>();
+}
+
+TEST(Simd, SumOfEmpty) {
+	EXPECT_EQ(uutils::simd::sum<int>(nullptr, 0), 0);
+}
+
+TEST(Simd, FindByte) {
+	// Every length around the 16 and 32 byte blocks, with the needle at every position
+	for (std::size_t size = 0; size <= 100; ++size)
+	{
+		std::string text(size, 'a');
+		const char* first = text.data();
+		const char* last = first + size;
+		EXPECT_EQ(uutils::simd::find_byte(first, last, ','), last);
+		for (std::size_t at = 0; at < size; ++at)
+		{
+			text[at] = ',';
+			if (at + 1 < size) text[size - 1] = ',';
+			EXPECT_EQ(uutils::simd::find_byte(first, last, ','), first + at);
+			text.assign(size, 'a');
+		}
+	}
+}
+
+template <class T>
+static void check_select()
+{
+	using uutils::simd::Compare;
+	auto data = make_data<T>(301);
+	std::vector<std::uint32_t> selection(data.size());
+	T pivot = data[17];
+	T hi = data[42] > pivot ? data[42] : pivot;
+
+	auto check = [&]<Compare Op>()
+	{
+		std::size_t count = uutils::simd::select<Op>(data.data(), data.size(), pivot, hi, selection.data());
+		std::vector<std::uint32_t> expected;
+		for (std::uint32_t i = 0; i < data.size(); i++)
+			if (uutils::simd::compare<Op>(data[i], pivot, hi)) expected.push_back(i);
+		EXPECT_EQ(std::vector<std::uint32_t>(selection.begin(), selection.begin() + count), expected);
+	};
+	check.template operator()<Compare::Less>();
+	check.template operator()<Compare::LessEqual>();
+	check.template operator()<Compare::Greater>();
+	check.template operator()<Compare::GreaterEqual>();
+	check.template operator()<Compare::Equal>();
+	check.template operator()<Compare::NotEqual>();
+	check.template operator()<Compare::Between>();
+}
+
+TEST(Simd, Select) {
+	check_select<std::int32_t>();
+	check_select<std::int64_t>();
+	check_select<float>();
+	check_select<double>();
+	check_select<std::int16_t>();
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <uutils/data_processing.h>
+#include <uutils/small_vector.h>
+
+TEST(SmallVector, ConstructEmpty) {
+	uutils::SmallVector<int, 10> vector;
+
+	EXPECT_EQ(vector.size(), 0);
+	EXPECT_EQ(vector.capacity(), 10);
+	EXPECT_TRUE(vector.is_inline());
+}
+
+TEST(SmallVector, ConstructFromInitializerList) {
+	uutils::SmallVector<int, 4> vector{ 1, 2, 3, 4, 5 };
+
+	EXPECT_EQ(vector.size(), 5);
+	EXPECT_FALSE(vector.is_inline());
+	EXPECT_EQ(vector.at(1), 2);
+	EXPECT_THROW(vector.at(5), std::out_of_range);
+}
+
+TEST(SmallVector, SpillsToHeap) {
+	uutils::SmallVector<std::string, 2> vector;
+
+	vector.push_back("a");
+	vector.push_back("b");
+	EXPECT_TRUE(vector.is_inline());
+
+	vector.push_back(vector.front());
+	EXPECT_FALSE(vector.is_inline());
+	EXPECT_EQ(vector.size(), 3);
+	EXPECT_EQ(vector[2], "a");
+
+	for (int i = 0; i < 100; i++)
+		vector.push_back(std::to_string(i));
+	EXPECT_EQ(vector.size(), 103);
+	EXPECT_EQ(vector.back(), "99");
+}
+
+TEST(SmallVector, Modify) {
+	uutils::SmallVector<int, 3> vector{ 10, 20, 30 };
+
+	vector.erase(vector.begin());
+	EXPECT_EQ(vector.size(), 2);
+	EXPECT_EQ(vector.front(), 20);
+
+	vector.pop_back();
+	EXPECT_EQ(vector.size(), 1);
+	EXPECT_EQ(vector.back(), 20);
+
+	int sum = 0;
+	for (int v : vector) sum += v;
+	EXPECT_EQ(sum, 20);
+}
+
+TEST(SmallVector, ReserveAndShrink) {
+	uutils::SmallVector<std::unique_ptr<int>, 4> vector;
+
+	vector.reserve(64);
+	EXPECT_EQ(vector.capacity(), 64);
+	for (int i = 0; i < 3; i++)
+		vector.push_back(std::make_unique<int>(i));
+
+	vector.shrink_to_fit();
+	EXPECT_TRUE(vector.is_inline());
+	EXPECT_EQ(*vector[2], 2);
+}
+
+TEST(SmallVector, CopyAndMove) {
+	uutils::SmallVector<std::string, 2> small{ "x" };
+	uutils::SmallVector<std::string, 2> large{ "a", "b", "c" };
+
+	auto small_copy = small;
+	auto large_copy = large;
+	EXPECT_EQ(small_copy[0], "x");
+	EXPECT_EQ(large_copy[2], "c");
+
+	const std::string* heap = large.data();
+	auto moved = std::move(large);
+	EXPECT_EQ(moved.data(), heap);
+	EXPECT_TRUE(large.empty());
+
+	moved = std::move(small);
+	EXPECT_EQ(moved.size(), 1);
+	EXPECT_TRUE(moved.is_inline());
+}
+
+// Counts live objects; copies throw once the budget runs out and moves may throw
+struct Fragile
+{
+	static inline int live = 0;
+	static inline int copies_left = 0;
+
+	int value;
+
+	Fragile(int v) : value(v) { ++live; }
+	Fragile(const Fragile& other) : value(other.value)
+	{
+		if (copies_left-- == 0) throw std::runtime_error("copy");
+		++live;
+	}
+	Fragile(Fragile&& other) noexcept(false) : value(other.value) { ++live; }
+	Fragile& operator=(const Fragile&) = default;
+	~Fragile() { --live; }
+};
+
+TEST(SmallVector, GrowthKeepsElementsIfCopyThrows) {
+	{
+		uutils::SmallVector<Fragile, 2> vector;
+		vector.emplace_back(1);
+		vector.emplace_back(2);
+
+		// The move constructor may throw, so growing copies and a failed copy changes nothing
+		Fragile::copies_left = 1;
+		EXPECT_THROW(vector.emplace_back(3), std::runtime_error);
+		EXPECT_EQ(vector.size(), 2);
+		EXPECT_TRUE(vector.is_inline());
+		EXPECT_EQ(vector[0].value, 1);
+		EXPECT_EQ(vector[1].value, 2);
+		EXPECT_EQ(Fragile::live, 2);
+
+		Fragile::copies_left = 0;
+		EXPECT_THROW(vector.reserve(16), std::runtime_error);
+		EXPECT_EQ(vector.capacity(), 2);
+		EXPECT_EQ(Fragile::live, 2);
+
+		Fragile::copies_left = 100;
+		vector.emplace_back(3);
+		EXPECT_EQ(vector.size(), 3);
+		EXPECT_EQ(vector[2].value, 3);
+	}
+	EXPECT_EQ(Fragile::live, 0);
+}
+
+TEST(SmallVector, PipelineTerminal) {
+	using namespace uutils::data_processing;
+
+	auto few = range(0, 10) > filter([](int x) { return x % 4 == 0; }) > to_small_vector<4>();
+	auto many = range(0, 100) > to_small_vector<4>();
+
+	EXPECT_EQ(few.size(), 3);
+	EXPECT_TRUE(few.is_inline());
+	EXPECT_EQ(many.size(), 100);
+	EXPECT_EQ(many.capacity(), 100);
+}
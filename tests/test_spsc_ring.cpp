@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+
+#include <uutils/spsc_ring.h>
+
+TEST(SpscRing, FullAndEmpty) {
+	uutils::SpscRing<int> ring(3);
+	int value = 0;
+
+	EXPECT_EQ(ring.capacity(), 4);
+	EXPECT_FALSE(ring.try_pop(value));
+	for (int i = 0; i < 4; i++)
+		EXPECT_TRUE(ring.try_push(i));
+	EXPECT_FALSE(ring.try_push(4));
+
+	EXPECT_TRUE(ring.try_pop(value));
+	EXPECT_EQ(value, 0);
+	EXPECT_TRUE(ring.try_push(4));
+}
+
+TEST(SpscRing, FailedPushKeepsValue) {
+	uutils::SpscRing<std::unique_ptr<int>> ring(1);
+
+	EXPECT_TRUE(ring.try_push(std::make_unique<int>(1)));
+	auto second = std::make_unique<int>(2);
+	EXPECT_FALSE(ring.try_push(std::move(second)));
+	ASSERT_NE(second, nullptr);
+	EXPECT_EQ(*second, 2);
+}
+
+TEST(SpscRing, TwoThreads) {
+	constexpr long long count = 200000;
+	uutils::SpscRing<long long> ring(64);
+
+	std::thread producer([&] {
+		for (long long i = 0; i < count; i++)
+			while (!ring.try_push(i)) std::this_thread::yield();
+	});
+
+	long long expected = 0;
+	long long value = 0;
+	bool in_order = true;
+	while (expected < count)
+	{
+		if (!ring.try_pop(value))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		in_order = in_order && value == expected;
+		expected++;
+	}
+	producer.join();
+
+	EXPECT_TRUE(in_order);
+}
@@ -1,4 +1,8 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
 
 #include <uutils/static_vector.h>
 
@@ -56,4 +60,130 @@ TEST(StaticVector, Modify) {
 	vector.push_back(4);
 	vector.push_back(5);
 	EXPECT_THROW(vector.push_back(6), std::length_error);
+}
+
+TEST(StaticVector, CopyAndMove) {
+	uutils::StaticVector<std::string, 4> strings{ "a long string that does not fit in SSO", "b" };
+
+	auto copy = strings;
+	EXPECT_EQ(copy.size(), 2);
+	EXPECT_EQ(copy[0], strings[0]);
+	EXPECT_NE(copy[0].data(), strings[0].data());
+
+	auto moved = std::move(strings);
+	EXPECT_EQ(moved[1], "b");
+	EXPECT_TRUE(strings.empty());
+
+	copy = moved;
+	moved = std::move(copy);
+	EXPECT_EQ(moved.size(), 2);
+
+	uutils::StaticVector<int, 4> ints{ 1, 2, 3 };
+	uutils::StaticVector<int, 4> other;
+	other = ints;
+	EXPECT_EQ(other.size(), 3);
+	EXPECT_EQ(other[2], 3);
+}
+
+TEST(StaticVector, Insert) {
+	std::vector<int> source{ 7, 8 };
+	uutils::StaticVector<int, 6> ints{ 1, 2, 3 };
+
+	ints.insert(ints.begin() + 1, source.begin(), source.end());
+	EXPECT_EQ(ints.size(), 5);
+	EXPECT_EQ(ints[1], 7);
+	EXPECT_EQ(ints[3], 2);
+	EXPECT_THROW(ints.insert(ints.end(), source.begin(), source.end()), std::length_error);
+	EXPECT_EQ(ints.size(), 5);
+
+	uutils::StaticVector<std::string, 4> strings{ "a", "d" };
+	auto it = strings.insert(strings.begin() + 1, { "b", "c" });
+	EXPECT_EQ(*it, "b");
+	EXPECT_EQ(strings[2], "c");
+	EXPECT_EQ(strings.back(), "d");
+}
+
+TEST(StaticVector, InsertFromItself) {
+	// Every insert position and every source subrange of the vector itself, against std::vector
+	for (std::size_t pos = 0; pos <= 5; pos++)
+		for (std::size_t from = 0; from <= 5; from++)
+			for (std::size_t to = from; to <= 5; to++)
+			{
+				uutils::StaticVector<int, 16> ints{ 0, 1, 2, 3, 4 };
+				std::vector<int> expected{ 0, 1, 2, 3, 4 };
+				std::vector<int> source(expected.begin() + from, expected.begin() + to);
+				expected.insert(expected.begin() + pos, source.begin(), source.end());
+
+				ints.insert(ints.begin() + pos, ints.begin() + from, ints.begin() + to);
+				EXPECT_EQ(std::vector<int>(ints.begin(), ints.end()), expected) << pos << " " << from << " " << to;
+
+				uutils::StaticVector<int, 16> reversed{ 0, 1, 2, 3, 4 };
+				std::reverse(source.begin(), source.end());
+				expected.assign({ 0, 1, 2, 3, 4 });
+				expected.insert(expected.begin() + pos, source.begin(), source.end());
+				reversed.insert(reversed.begin() + pos, std::make_reverse_iterator(reversed.begin() + to), std::make_reverse_iterator(reversed.begin() + from));
+				EXPECT_EQ(std::vector<int>(reversed.begin(), reversed.end()), expected) << pos << " " << from << " " << to;
+			}
+
+	uutils::StaticVector<int, 8> ints{ 1, 2, 3 };
+	ints.insert(ints.begin(), ints.data() + 1, ints.data() + 3);
+	EXPECT_EQ(std::vector<int>(ints.begin(), ints.end()), (std::vector<int>{ 2, 3, 1, 2, 3 }));
+
+	uutils::StaticVector<std::string, 8> strings{ "a", "b", "c" };
+	strings.insert(strings.begin(), strings.begin() + 1, strings.end());
+	EXPECT_EQ(std::vector<std::string>(strings.begin(), strings.end()), (std::vector<std::string>{ "b", "c", "a", "b", "c" }));
+}
+
+TEST(StaticVector, EraseRange) {
+	uutils::StaticVector<std::string, 5> strings{ "a", "b", "c", "d", "e" };
+
+	auto it = strings.erase(strings.begin() + 1, strings.begin() + 3);
+	EXPECT_EQ(*it, "d");
+	EXPECT_EQ(strings.size(), 3);
+	EXPECT_EQ(strings.back(), "e");
+
+	uutils::StaticVector<int, 5> ints{ 1, 2, 3, 4, 5 };
+	ints.erase(ints.begin(), ints.begin() + 4);
+	EXPECT_EQ(ints.size(), 1);
+	EXPECT_EQ(ints[0], 5);
+	EXPECT_THROW(ints.erase(ints.begin(), ints.begin() + 2), std::out_of_range);
+}
+
+TEST(StaticVector, EraseIf) {
+	uutils::StaticVector<std::string, 6> strings{ "x", "a", "x", "b", "x", "c" };
+
+	EXPECT_EQ(strings.erase_if([](const std::string& s) { return s == "x"; }), 3);
+	EXPECT_EQ(strings.size(), 3);
+	EXPECT_EQ(strings[0], "a");
+	EXPECT_EQ(strings[2], "c");
+}
+
+TEST(StaticVector, UnorderedErase) {
+	uutils::StaticVector<int, 4> ints{ 1, 2, 3, 4 };
+
+	ints.unordered_erase(ints.begin());
+	EXPECT_EQ(ints.size(), 3);
+	EXPECT_EQ(ints[0], 4);
+	ints.unordered_erase(ints.begin() + 2);
+	EXPECT_EQ(ints.size(), 2);
+	EXPECT_EQ(ints.back(), 2);
+}
+
+TEST(StaticVector, ResizeAndAssign) {
+	uutils::StaticVector<std::string, 4> strings;
+
+	strings.resize(3, "z");
+	EXPECT_EQ(strings.size(), 3);
+	EXPECT_EQ(strings[2], "z");
+	strings.resize(1);
+	EXPECT_EQ(strings.size(), 1);
+	EXPECT_THROW(strings.resize(5), std::length_error);
+
+	strings.assign(2, "y");
+	EXPECT_EQ(strings.size(), 2);
+	EXPECT_EQ(strings[1], "y");
+
+	strings.assign({ "p", "q", "r" });
+	EXPECT_EQ(strings.size(), 3);
+	EXPECT_EQ(strings.front(), "p");
 }
\ No newline at end of file
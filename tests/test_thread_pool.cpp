@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <uutils/thread_pool.h>
+
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnce) {
+	uutils::ThreadPool pool(4);
+	std::vector<std::atomic<int>> visits(1000);
+
+	pool.parallel_for(visits.size(), [&](std::size_t i) { visits[i]++; });
+
+	for (auto& v : visits)
+		EXPECT_EQ(v.load(), 1);
+}
+
+TEST(ThreadPool, ParallelForRethrows) {
+	uutils::ThreadPool pool(2);
+
+	EXPECT_THROW(pool.parallel_for(100, [](std::size_t i) { if (i == 42) throw std::runtime_error("42"); }), std::runtime_error);
+}
+
+TEST(ThreadPool, NestedParallelFor) {
+	uutils::ThreadPool pool(2);
+	std::atomic<int> count = 0;
+
+	pool.parallel_for(8, [&](std::size_t) {
+		pool.parallel_for(8, [&](std::size_t) { count++; });
+	});
+
+	EXPECT_EQ(count.load(), 64);
+}
+
+TEST(ThreadPool, SubmitRunsTask) {
+	std::atomic<bool> done = false;
+	{
+		uutils::ThreadPool pool(1);
+		pool.submit([&] { done = true; });
+	}
+	EXPECT_TRUE(done.load());
+}
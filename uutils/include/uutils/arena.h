@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+namespace uutils
+{
+	// Monotonic bump allocator: deallocation does nothing and all memory is given
+	// back at once by release() or the destructor. Meant for per-request scratch
+	// data, so it is not thread-safe.
+	class Arena : public std::pmr::memory_resource
+	{
+	public:
+		explicit Arena(std::size_t block_size = 4096, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+			: _first_block_size(block_size), _next_block_size(block_size), _upstream(upstream) {
+		}
+
+		// Serves allocations from caller-owned storage first, e.g. a buffer on the stack
+		Arena(void* buffer, std::size_t size, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+			: _initial(static_cast<std::byte*>(buffer)), _initial_size(size),
+			_current(static_cast<std::byte*>(buffer)), _end(static_cast<std::byte*>(buffer) + size),
+			_first_block_size(size > 0 ? size : 4096), _next_block_size(_first_block_size), _upstream(upstream) {
+		}
+
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		~Arena() override { release(); }
+
+		void release() noexcept
+		{
+			while (_blocks)
+			{
+				Block* next = _blocks->next;
+				_upstream->deallocate(_blocks, _blocks->size, alignof(std::max_align_t));
+				_blocks = next;
+			}
+			_current = _initial;
+			_end = _initial + _initial_size;
+			_next_block_size = _first_block_size;
+			_upstream_bytes = 0;
+		}
+
+		// Bytes currently held from the upstream resource
+		std::size_t upstream_bytes() const noexcept { return _upstream_bytes; }
+
+	protected:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override
+		{
+			if (void* p = bump(bytes, alignment)) return p;
+
+			std::size_t needed = sizeof(Block) + bytes + alignment;
+			std::size_t size = _next_block_size > needed ? _next_block_size : needed;
+			auto* block = static_cast<Block*>(_upstream->allocate(size, alignof(std::max_align_t)));
+			block->next = _blocks;
+			block->size = size;
+			_blocks = block;
+			_upstream_bytes += size;
+			_next_block_size = size * 2;
+
+			_current = reinterpret_cast<std::byte*>(block) + sizeof(Block);
+			_end = reinterpret_cast<std::byte*>(block) + size;
+			return bump(bytes, alignment);
+		}
+
+		void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+	private:
+		struct alignas(std::max_align_t) Block
+		{
+			Block* next;
+			std::size_t size;
+		};
+
+		std::byte* _initial = nullptr;
+		std::size_t _initial_size = 0;
+		std::byte* _current = nullptr;
+		std::byte* _end = nullptr;
+		Block* _blocks = nullptr;
+		std::size_t _first_block_size;
+		std::size_t _next_block_size;
+		std::size_t _upstream_bytes = 0;
+		std::pmr::memory_resource* _upstream;
+
+		void* bump(std::size_t bytes, std::size_t alignment) noexcept
+		{
+			if (!_current) return nullptr;
+			void* p = _current;
+			std::size_t space = static_cast<std::size_t>(_end - _current);
+			if (!std::align(alignment, bytes, p, space)) return nullptr;
+			_current = static_cast<std::byte*>(p) + bytes;
+			return p;
+		}
+	};
+
+	// Standard allocator over an Arena, for containers that do not take a memory_resource
+	template <class T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		ArenaAllocator(Arena& arena) noexcept : _arena(&arena) {}
+		template <class U>
+		ArenaAllocator(const ArenaAllocator<U>& other) noexcept : _arena(other.arena()) {}
+
+		T* allocate(std::size_t n) { return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T))); }
+		void deallocate(T*, std::size_t) noexcept {}
+
+		Arena* arena() const noexcept { return _arena; }
+
+		template <class U>
+		bool operator==(const ArenaAllocator<U>& other) const noexcept { return _arena == other.arena(); }
+
+	private:
+		Arena* _arena;
+	};
+}
@@ -2,12 +2,205 @@
 
 #include <type_traits>
 #include <functional>
+#include <iomanip>
 #include <iostream>
 #include <vector>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <variant>
+
+#include "flat_hash_map.h"
+#include "mapped_file.h"
+#include "simd.h"
+#include "small_vector.h"
+#include "spsc_ring.h"
+#include "static_vector.h"
+#include "thread_pool.h"
 
 namespace uutils::data_processing
 {
 	class Range;
+
+	struct ParallelPolicy
+	{
+		// 0 means "as many as the global thread pool has, plus the calling thread"
+		std::size_t threads = 0;
+	};
+
+	// Lets sum() regroup floating point additions so they can be vectorized
+	struct Reassociate {};
+
+	// Makes bounded collecting terminals drop what does not fit instead of throwing
+	struct Truncate {};
+
+	// Makes scans yield the total before each element instead of the one including it
+	struct Exclusive {};
+
+	// What profile() measured for one stage
+	struct StageReport
+	{
+		std::string name;
+		std::uint64_t in = 0;
+		std::uint64_t out = 0;
+		// Spent in the stage itself, without the stages before and after it
+		std::chrono::nanoseconds time{};
+
+		double selectivity() const { return in == 0 ? 1.0 : static_cast<double>(out) / static_cast<double>(in); }
+	};
+
+	// Collects per-stage counters of the pipelines built with profile(*this, ...).
+	// Stages are reported in the order they were added.
+	class Profile
+	{
+	public:
+		struct Counters
+		{
+			explicit Counters(std::string_view name) : name(name) {}
+
+			std::string name;
+			std::atomic<std::uint64_t> in{ 0 };
+			std::atomic<std::uint64_t> out{ 0 };
+			std::atomic<std::int64_t> nanoseconds{ 0 };
+			// Number of clock intervals that went into nanoseconds
+			std::atomic<std::uint64_t> timings{ 0 };
+		};
+
+		Profile() = default;
+		Profile(const Profile&) = delete;
+		Profile& operator=(const Profile&) = delete;
+
+		Counters& add_stage(std::string_view name) { return _stages.emplace_back(name); }
+
+		std::vector<StageReport> report() const
+		{
+			// Every interval also holds about one reading of the clock, which is not the stage's time
+			auto overhead = clock_overhead();
+			std::vector<StageReport> result;
+			for (const auto& stage : _stages)
+			{
+				auto nanoseconds = stage.nanoseconds.load() - static_cast<std::int64_t>(stage.timings.load()) * overhead;
+				result.push_back({ stage.name, stage.in.load(), stage.out.load(), std::chrono::nanoseconds(std::max<std::int64_t>(nanoseconds, 0)) });
+			}
+			return result;
+		}
+
+		// One line per stage: name, elements in and out, selectivity and milliseconds
+		void print(std::ostream& out) const
+		{
+			out << std::left << std::setw(24) << "stage" << std::right << std::setw(14) << "in" << std::setw(14) << "out"
+				<< std::setw(13) << "selectivity" << std::setw(12) << "ms" << '\n';
+			for (const auto& stage : report())
+			{
+				out << std::left << std::setw(24) << stage.name << std::right << std::setw(14) << stage.in << std::setw(14) << stage.out
+					<< std::fixed << std::setprecision(3) << std::setw(13) << stage.selectivity()
+					<< std::setw(12) << std::chrono::duration<double, std::milli>(stage.time).count() << '\n';
+			}
+		}
+
+	private:
+		// A deque, so the counters stay put while pipelines hold pointers to them
+		std::deque<Counters> _stages;
+
+		// Nanoseconds per steady_clock::now(), measured once
+		static std::int64_t clock_overhead()
+		{
+			static const std::int64_t overhead = []
+			{
+				using Clock = std::chrono::steady_clock;
+				constexpr int calls = 256;
+				std::int64_t best = std::numeric_limits<std::int64_t>::max();
+				for (int round = 0; round < 8; ++round)
+				{
+					auto start = Clock::now();
+					for (int i = 0; i < calls; ++i) (void)Clock::now();
+					best = std::min<std::int64_t>(best, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+				}
+				return best / calls;
+			}();
+			return overhead;
+		}
+	};
+
+	// Passed to profile() instead of a Profile to build the pipeline without instrumentation
+	struct NoProfile {};
+
+	// Aggregations for group_by. Each one starts a group's accumulator from its first
+	// item, folds further items into it, and merges two accumulators of the same key
+	// (the parallel group_by needs the merge).
+	namespace agg
+	{
+		struct Count
+		{
+			std::size_t first(const auto&) const { return 1; }
+			void update(std::size_t& acc, const auto&) const { ++acc; }
+			void merge(std::size_t& acc, std::size_t other) const { acc += other; }
+		};
+
+		template <class Func>
+		struct Sum
+		{
+			[[no_unique_address]] Func value;
+
+			auto first(const auto& item) const { return static_cast<std::remove_cvref_t<decltype(std::invoke(value, item))>>(std::invoke(value, item)); }
+			void update(auto& acc, const auto& item) const { acc += std::invoke(value, item); }
+			void merge(auto& acc, const auto& other) const { acc += other; }
+		};
+
+		template <class Func, bool Max>
+		struct Extreme
+		{
+			[[no_unique_address]] Func value;
+
+			auto first(const auto& item) const { return static_cast<std::remove_cvref_t<decltype(std::invoke(value, item))>>(std::invoke(value, item)); }
+			void update(auto& acc, const auto& item) const { merge(acc, std::invoke(value, item)); }
+			void merge(auto& acc, const auto& other) const
+			{
+				if (Max ? acc < other : other < acc) acc = other;
+			}
+		};
+
+		template <class T, class Func, class Merge>
+		struct Fold
+		{
+			T init;
+			[[no_unique_address]] Func func;
+			[[no_unique_address]] Merge merge_func;
+
+			T first(const auto& item) const { return std::invoke(func, init, item); }
+			void update(T& acc, const auto& item) const { acc = std::invoke(func, std::move(acc), item); }
+			void merge(T& acc, T&& other) const requires (!std::is_same_v<Merge, std::nullptr_t>)
+			{
+				acc = std::invoke(merge_func, std::move(acc), std::move(other));
+			}
+		};
+
+		constexpr auto count() { return Count{}; }
+		// value(item) selects what to sum/compare, the item itself by default
+		template <class Func = std::identity> constexpr auto sum(Func value = {}) { return Sum<Func>{ value }; }
+		template <class Func = std::identity> constexpr auto min(Func value = {}) { return Extreme<Func, false>{ value }; }
+		template <class Func = std::identity> constexpr auto max(Func value = {}) { return Extreme<Func, true>{ value }; }
+		// acc = func(acc, item) starting from init; merge(acc, acc) is only needed by the parallel group_by
+		template <class T, class Func> constexpr auto fold(T init, Func func) { return Fold<T, Func, std::nullptr_t>{ std::move(init), func, nullptr }; }
+		template <class T, class Func, class Merge> constexpr auto fold(T init, Func func, Merge merge) { return Fold<T, Func, Merge>{ std::move(init), func, merge }; }
+	}
+
 	namespace detail
 	{
 		template <class T>
@@ -29,8 +222,129 @@ namespace uutils::data_processing
 			requires std::is_void_v<std::invoke_result_t<F, Arg>>;
 		};
 
+		// Ranges that can be cut into independent pieces by index over their source,
+		// which is what the parallel terminals need.
+		template <class T>
+		concept Splittable = requires(const std::remove_cvref_t<T>& range, std::size_t index)
+		{
+			{ range.split_size() } -> std::convertible_to<std::size_t>;
+			range.slice(index, index);
+		};
+
+		// Ranges that know how many elements they have without walking them
+		template <class T>
+		concept Sized = requires(const std::remove_cvref_t<T>& range)
+		{
+			{ range.size() } -> std::convertible_to<std::size_t>;
+		};
+
+		struct AnySink
+		{
+			template <class T>
+			constexpr bool operator()(T&&) const { return true; }
+		};
+
+		// Ranges that can drive a sink themselves: push(sink) calls sink(item) for
+		// every element until the sink returns false, and returns false if it was
+		// stopped that way. This avoids the nested iterator comparisons of the pull
+		// model, so terminals prefer it whenever the whole pipeline supports it.
+		template <class T>
+		concept Pushable = requires(const std::remove_cvref_t<T>& range, AnySink sink)
+		{
+			{ range.push(sink) } -> std::convertible_to<bool>;
+		};
+
+		template <class T>
+		using iterator_t = decltype(std::declval<const std::remove_cvref_t<T>&>().begin());
+		template <class T>
+		using sentinel_t = decltype(std::declval<const std::remove_cvref_t<T>&>().end());
+
+		// Ranges whose end() is an iterator. Others end in a sentinel that iterators are
+		// only compared against, so finding the end costs nothing up front.
+		template <class T>
+		concept CommonRange = std::same_as<iterator_t<T>, sentinel_t<T>>;
+
+		// End of an adaptor whose upstream ends in a sentinel: the adaptor's iterators
+		// compare their upstream position against the upstream one
+		template <class End>
+		struct Sentinel
+		{
+			End end;
+		};
+
+		template <class A>
+		concept AllocatorLike = requires(A& allocator)
+		{
+			typename A::value_type;
+			allocator.allocate(std::size_t{ 1 });
+		};
+
+		template <class It>
+		concept BidirectionalIterator = requires(It it) { --it; };
+
+		template <class It>
+		concept RandomAccessIterator = BidirectionalIterator<It> && requires(It it, const It& other, std::ptrdiff_t n)
+		{
+			it += n;
+			it -= n;
+			{ other - other } -> std::convertible_to<std::ptrdiff_t>;
+			other < other;
+		};
+
+		// Iterators whose operator* returns a reference into the iterator itself, so
+		// the reference dies with the iterator
+		template <class It>
+		concept StashingIterator = requires { requires It::stashing; };
+
+		struct Empty {};
+
+		template <class It>
+		using iterator_category_t = std::conditional_t<RandomAccessIterator<It>, std::random_access_iterator_tag,
+			std::conditional_t<BidirectionalIterator<It>, std::bidirectional_iterator_tag, std::forward_iterator_tag>>;
+
+		// Moves it forward by up to n steps without passing end. O(1) for random-access iterators.
+		template <class It, class End, std::integral TNumber>
+		constexpr It bounded_advance(It it, const End& end, TNumber n)
+		{
+			if (n <= 0) return it;
+			if constexpr (RandomAccessIterator<It> && std::same_as<It, End>)
+			{
+				auto left = static_cast<std::size_t>(end - it);
+				it += static_cast<std::ptrdiff_t>(std::min(left, static_cast<std::size_t>(n)));
+			}
+			else
+			{
+				for (TNumber i = static_cast<TNumber>(0); it != end && i < n; i++)
+				{
+					++it;
+				}
+			}
+			return it;
+		}
+
+		template <std::integral TNumber>
+		constexpr std::size_t clamp_count(TNumber n, std::size_t size)
+		{
+			return n <= 0 ? 0 : std::min(size, static_cast<std::size_t>(n));
+		}
+
+		// The end of a range as an iterator, which takes a walk if it ends in a sentinel
+		template <class TRange>
+		constexpr auto end_iterator(const TRange& range)
+		{
+			if constexpr (CommonRange<TRange>)
+				return range.end();
+			else
+			{
+				auto it = range.begin();
+				for (auto end = range.end(); it != end; ++it) {}
+				return it;
+			}
+		}
+
 
-		template <class TIterator>
+		// TOwner keeps whatever the iterators point into alive, e.g. a file mapping
+		template <class TIterator, class TOwner = Empty>
 		class TRange
 		{
 		public:
@@ -38,17 +352,69 @@ namespace uutils::data_processing
 			constexpr TIterator begin() const { return _begin; }
 			constexpr TIterator end() const { return _end; }
 
+			constexpr std::size_t size() const requires RandomAccessIterator<TIterator>
+			{
+				return static_cast<std::size_t>(_end - _begin);
+			}
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const
+			{
+				for (TIterator it = _begin; it != _end; ++it)
+				{
+					if (!sink(*it)) return false;
+				}
+				return true;
+			}
+
+			constexpr std::size_t split_size() const requires RandomAccessIterator<TIterator> { return size(); }
+			constexpr TRange slice(std::size_t from, std::size_t to) const requires RandomAccessIterator<TIterator>
+			{
+				using Diff = std::iter_difference_t<TIterator>;
+				return TRange(_begin + static_cast<Diff>(from), _begin + static_cast<Diff>(to), _owner);
+			}
+
 		private:
 			TIterator _begin;
 			TIterator _end;
+			[[no_unique_address]] TOwner _owner;
 
-			constexpr TRange(TIterator begin, TIterator end)
-				: _begin(begin), _end(end) {
+			constexpr TRange(TIterator begin, TIterator end, TOwner owner = {})
+				: _begin(begin), _end(end), _owner(std::move(owner)) {
 			}
 
 			friend class ::uutils::data_processing::Range;
 		};
 
+		// What an iterator keeps of its stage's callable. Stateless callables are copied,
+		// which takes no space; anything else is reached through the stage, which has to
+		// outlive its iterators, so that iterators stay small and callables are not copied.
+		template <class Func>
+		class FuncRef
+		{
+		public:
+			constexpr FuncRef(const Func& func) : _func(store(func)) {}
+
+			template <class... Args>
+			constexpr decltype(auto) operator()(Args&&... args) const { return get()(std::forward<Args>(args)...); }
+			constexpr const Func& get() const
+			{
+				if constexpr (by_value) return _func;
+				else return *_func;
+			}
+
+		private:
+			static constexpr bool by_value = std::is_empty_v<Func> && std::is_copy_constructible_v<Func>;
+
+			[[no_unique_address]] std::conditional_t<by_value, Func, const Func*> _func;
+
+			static constexpr auto store(const Func& func)
+			{
+				if constexpr (by_value) return func;
+				else return &func;
+			}
+		};
+
 		template <class TRange, class Func>
 		class TMap
 		{
@@ -56,308 +422,2939 @@ namespace uutils::data_processing
 			class Iterator
 			{
 			public:
-				using It = decltype(std::declval<TRange>().begin());
-				constexpr Iterator(It it, Func func) : _it(it), _func(func) {}
+				using It = iterator_t<TRange>;
+				using reference = decltype(std::declval<const Func&>()(*std::declval<It>()));
+				using value_type = std::remove_cvref_t<reference>;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = iterator_category_t<It>;
 
-				constexpr auto operator*() const { return _func(*_it); }
+				constexpr Iterator(It it, FuncRef<Func> func) : _it(it), _func(func) {}
+
+				constexpr reference operator*() const { return _func(*_it); }
 				constexpr Iterator& operator++() { ++_it; return *this; }
-				constexpr Iterator& operator--() { --_it; return *this; }
+				constexpr Iterator& operator--() requires BidirectionalIterator<It> { --_it; return *this; }
+				constexpr bool operator==(const Iterator& other) const { return !(_it != other._it); }
 				constexpr bool operator!=(const Iterator& other) const { return _it != other._it; }
+				template <class End>
+				constexpr bool operator==(const Sentinel<End>& end) const { return !(_it != end.end); }
+
+				constexpr Iterator& operator+=(difference_type n) requires RandomAccessIterator<It> { _it += n; return *this; }
+				constexpr Iterator& operator-=(difference_type n) requires RandomAccessIterator<It> { _it -= n; return *this; }
+				constexpr Iterator operator+(difference_type n) const requires RandomAccessIterator<It> { return Iterator(_it + n, _func); }
+				constexpr Iterator operator-(difference_type n) const requires RandomAccessIterator<It> { return Iterator(_it - n, _func); }
+				constexpr difference_type operator-(const Iterator& other) const requires RandomAccessIterator<It> { return _it - other._it; }
+				constexpr reference operator[](difference_type n) const requires RandomAccessIterator<It> { return _func(*(_it + n)); }
+				constexpr bool operator<(const Iterator& other) const requires RandomAccessIterator<It> { return _it < other._it; }
 
 			private:
 				It _it;
-				Func _func;
+				[[no_unique_address]] FuncRef<Func> _func;
 			};
 
 			constexpr TMap(TRange range, Func func)
-				: _range(std::move(range)), _func(func) {
+				: _range(std::forward<TRange>(range)), _func(std::move(func)) {
 			}
 
 			constexpr Iterator begin() const { return Iterator(_range.begin(), _func); }
-			constexpr Iterator end() const { return Iterator(_range.end(), _func); }
+			constexpr auto end() const
+			{
+				if constexpr (CommonRange<TRange>) return Iterator(_range.end(), _func);
+				else return Sentinel<sentinel_t<TRange>>{ _range.end() };
+			}
+
+			constexpr std::size_t size() const requires Sized<TRange> { return _range.size(); }
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const requires Pushable<TRange>
+			{
+				return _range.push([&](auto&& item) { return sink(_func(std::forward<decltype(item)>(item))); });
+			}
+
+			constexpr std::size_t split_size() const requires Splittable<TRange> { return _range.split_size(); }
+			// Every slice gets a copy of the callable, so move-only ones are not split
+			constexpr auto slice(std::size_t from, std::size_t to) const requires Splittable<TRange> && std::copy_constructible<Func>
+			{
+				return TMap<decltype(_range.slice(from, to)), Func>(_range.slice(from, to), _func);
+			}
+
+			constexpr const auto& base() const { return _range; }
+			constexpr const Func& function() const { return _func; }
 
 		private:
 			TRange _range;
-			Func _func;
+			[[no_unique_address]] Func _func;
 		};
 
+		// Factories give every pipeline they build a copy of the callable. A move-only
+		// callable is moved into the first pipeline instead, so it can only build one.
+		template <class Func, class Make>
+		constexpr auto stage_factory(Func func, Make make)
+		{
+			if constexpr (std::copy_constructible<Func>)
+				return [=](auto&& range) { return make(std::forward<decltype(range)>(range), func); };
+			else
+				return [func = std::move(func), make](auto&& range) mutable { return make(std::forward<decltype(range)>(range), std::move(func)); };
+		}
+
 		template <typename TRange, class Func>
 		constexpr auto map_impl(TRange&& range, Func func)
 		{
-			return TMap<TRange, Func>(std::forward<TRange>(range), func);
+			return TMap<TRange, Func>(std::forward<TRange>(range), std::move(func));
+		}
+
+		// Calls func on every element and passes it on unchanged, moving prvalues through
+		template <class Func>
+		struct Inspector
+		{
+			[[no_unique_address]] Func func;
+
+			template <class T>
+			constexpr T operator()(T&& item) const
+			{
+				func(std::as_const(item));
+				return std::forward<T>(item);
+			}
+		};
+
+		template <typename TRange, class Func>
+		constexpr auto inspect_impl(TRange&& range, Func func)
+		{
+			return map_impl(std::forward<TRange>(range), Inspector<Func>{ std::move(func) });
+		}
+
+		// Sits on the input or the output side of a profiled stage and counts the
+		// elements that pass it. The stage's own time is what it spends between the
+		// two probes: pushing, the input probe times everything downstream of it and the
+		// output probe subtracts what comes after the stage; pulling, the output probe
+		// times everything upstream and the input probe subtracts what comes before.
+		template <class TRange, bool Output>
+		class TProbe
+		{
+		public:
+			using Counters = Profile::Counters;
+			using Clock = std::chrono::steady_clock;
+
+			// Adds the time until destruction as a pull-side measurement
+			class PullTimer
+			{
+			public:
+				explicit PullTimer(Counters* counters) : _counters(counters) {}
+				~PullTimer()
+				{
+					auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start).count();
+					_counters->nanoseconds.fetch_add(Output ? elapsed : -elapsed, std::memory_order_relaxed);
+					_counters->timings.fetch_add(1, std::memory_order_relaxed);
+				}
+
+			private:
+				Counters* _counters;
+				Clock::time_point _start = Clock::now();
+			};
+
+			class Iterator
+			{
+			public:
+				using It = iterator_t<TRange>;
+				static constexpr bool stashing = StashingIterator<It>;
+				using reference = decltype(*std::declval<It>());
+				using value_type = std::remove_cvref_t<reference>;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = iterator_category_t<It>;
+
+				Iterator(It it, Counters* counters) : _it(it), _counters(counters) {}
+
+				reference operator*() const { PullTimer timer(_counters); return *_it; }
+				Iterator& operator++()
+				{
+					{
+						PullTimer timer(_counters);
+						++_it;
+					}
+					(Output ? _counters->out : _counters->in).fetch_add(1, std::memory_order_relaxed);
+					return *this;
+				}
+				Iterator& operator--() requires BidirectionalIterator<It> { --_it; return *this; }
+				bool operator==(const Iterator& other) const { return !(_it != other._it); }
+				bool operator!=(const Iterator& other) const { return _it != other._it; }
+				template <class End>
+				bool operator==(const Sentinel<End>& end) const { PullTimer timer(_counters); return !(_it != end.end); }
+
+				Iterator& operator+=(difference_type n) requires RandomAccessIterator<It> { _it += n; return *this; }
+				Iterator& operator-=(difference_type n) requires RandomAccessIterator<It> { _it -= n; return *this; }
+				Iterator operator+(difference_type n) const requires RandomAccessIterator<It> { return Iterator(_it + n, _counters); }
+				Iterator operator-(difference_type n) const requires RandomAccessIterator<It> { return Iterator(_it - n, _counters); }
+				difference_type operator-(const Iterator& other) const requires RandomAccessIterator<It> { return _it - other._it; }
+				reference operator[](difference_type n) const requires RandomAccessIterator<It> { PullTimer timer(_counters); return _it[n]; }
+				bool operator<(const Iterator& other) const requires RandomAccessIterator<It> { return _it < other._it; }
+
+			private:
+				It _it;
+				Counters* _counters;
+			};
+
+			TProbe(TRange range, Counters* counters)
+				: _range(std::forward<TRange>(range)), _counters(counters) {
+			}
+
+			Iterator begin() const { PullTimer timer(_counters); return Iterator(_range.begin(), _counters); }
+			auto end() const
+			{
+				PullTimer timer(_counters);
+				if constexpr (CommonRange<TRange>) return Iterator(_range.end(), _counters);
+				else return Sentinel<sentinel_t<TRange>>{ _range.end() };
+			}
+
+			std::size_t size() const requires Sized<TRange> { return _range.size(); }
+
+			template <class Sink>
+			bool push(Sink&& sink) const requires Pushable<TRange>
+			{
+				// Counted locally and added once, so parallel slices do not contend
+				std::uint64_t count = 0;
+				std::int64_t elapsed = 0;
+				bool result = _range.push([&](auto&& item)
+				{
+					++count;
+					auto start = Clock::now();
+					bool more = sink(std::forward<decltype(item)>(item));
+					elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+					return more;
+				});
+				(Output ? _counters->out : _counters->in).fetch_add(count, std::memory_order_relaxed);
+				_counters->nanoseconds.fetch_add(Output ? -elapsed : elapsed, std::memory_order_relaxed);
+				_counters->timings.fetch_add(count, std::memory_order_relaxed);
+				return result;
+			}
+
+			std::size_t split_size() const requires Splittable<TRange> { return _range.split_size(); }
+			auto slice(std::size_t from, std::size_t to) const requires Splittable<TRange>
+			{
+				return TProbe<decltype(_range.slice(from, to)), Output>(_range.slice(from, to), _counters);
+			}
+
+		private:
+			TRange _range;
+			Counters* _counters;
+		};
+
+		template <typename TRange, class Stage>
+		auto profile_impl(TRange&& range, Profile::Counters& counters, const Stage& stage)
+		{
+			auto staged = stage(TProbe<TRange, false>(std::forward<TRange>(range), &counters));
+			return TProbe<decltype(staged), true>(std::move(staged), &counters);
 		}
 
+		// Comparison against constants, which filter can evaluate with SIMD compares
+		// over contiguous numeric sources instead of branching per element
+		template <simd::Compare Op, class T>
+		struct ComparePredicate
+		{
+			static constexpr simd::Compare op = Op;
+			T a;
+			T b;
+
+			template <class U>
+			constexpr bool operator()(const U& x) const { return simd::compare<Op>(x, a, b); }
+		};
+
+		template <class T>
+		struct IsComparePredicate : std::false_type {};
+		template <simd::Compare Op, class T>
+		struct IsComparePredicate<ComparePredicate<Op, T>> : std::true_type {};
+
+		// Defined with the block machinery further down
+		template <class TRange, class Func, class Sink>
+		constexpr bool filter_push(const TRange& range, const Func& func, Sink& sink);
+
 		template <class TRange, class Func>
 		class TFilter
 		{
 		public:
 			class Iterator
 			{
-			public:
-				using It = decltype(std::declval<TRange>().begin());
-				constexpr Iterator(It it, It end, It begin, Func func)
-					: _it(it), _end(end), _begin(begin), _func(func) {
-					advance();
-				}
+			public:
+				using It = iterator_t<TRange>;
+				using End = sentinel_t<TRange>;
+				// Values the upstream computes on dereference (e.g. in a map) are kept once
+				// the predicate has seen them, so they are not computed a second time for
+				// operator*
+				static constexpr bool stashing = !std::is_reference_v<decltype(*std::declval<It>())>;
+				using value_type = std::remove_cvref_t<decltype(*std::declval<It>())>;
+				using reference = std::conditional_t<stashing, const value_type&, decltype(*std::declval<It>())>;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::conditional_t<BidirectionalIterator<It>, std::bidirectional_iterator_tag, std::forward_iterator_tag>;
+
+				constexpr Iterator(It it, End end, FuncRef<Func> func)
+					: _it(it), _end(end), _func(func) {
+					advance();
+				}
+
+				constexpr reference operator*() const
+				{
+					if constexpr (stashing) return *_cache;
+					else return *_it;
+				}
+				constexpr Iterator& operator++()
+				{
+					++_it;
+					advance();
+					return *this;
+				}
+				constexpr Iterator& operator--() requires BidirectionalIterator<It>
+				{
+					do
+					{
+						--_it;
+						load();
+					} while (!_func(**this));
+					return *this;
+				}
+				constexpr bool operator==(const Iterator& other) const { return !(_it != other._it); }
+				constexpr bool operator!=(const Iterator& other) const { return _it != other._it; }
+				constexpr bool operator==(std::default_sentinel_t) const { return !(_it != _end); }
+
+			private:
+				It _it;
+				End _end;
+				[[no_unique_address]] FuncRef<Func> _func;
+				[[no_unique_address]] std::conditional_t<stashing, std::optional<value_type>, Empty> _cache;
+
+				constexpr void load()
+				{
+					if constexpr (stashing) _cache.emplace(*_it);
+				}
+
+				constexpr void advance()
+				{
+					for (; _it != _end; ++_it)
+					{
+						load();
+						if (_func(**this)) return;
+					}
+				}
+			};
+
+			constexpr TFilter(TRange range, Func func)
+				: _range(std::forward<TRange>(range)), _func(std::move(func)) {
+			}
+
+			constexpr Iterator begin() const { return Iterator(_range.begin(), _range.end(), _func); }
+			// Iterators know where the upstream ends, so the end is a sentinel that costs
+			// nothing. reverse() needs it as an iterator, which it can have when the
+			// upstream has one too.
+			constexpr auto end() const
+			{
+				if constexpr (CommonRange<TRange> && BidirectionalIterator<iterator_t<TRange>>) return Iterator(_range.end(), _range.end(), _func);
+				else return std::default_sentinel;
+			}
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const requires Pushable<TRange>
+			{
+				return filter_push(_range, _func, sink);
+			}
+
+			constexpr std::size_t split_size() const requires Splittable<TRange> { return _range.split_size(); }
+			constexpr auto slice(std::size_t from, std::size_t to) const requires Splittable<TRange> && std::copy_constructible<Func>
+			{
+				return TFilter<decltype(_range.slice(from, to)), Func>(_range.slice(from, to), _func);
+			}
+
+		private:
+			TRange _range;
+			[[no_unique_address]] Func _func;
+		};
+
+		template <typename TRange, class Func>
+		constexpr auto filter_impl(TRange&& range, Func pred)
+		{
+			return TFilter<TRange, Func>(std::forward<TRange>(range), std::move(pred));
+		}
+
+		// Skipping does not change how the upstream is walked, so it hands out upstream
+		// iterators and only moves the begin.
+		template <class TRange, std::integral TNumber>
+		class TSkip
+		{
+		public:
+			using Iterator = iterator_t<TRange>;
+
+			constexpr TSkip(TRange range, TNumber skip)
+				: _range(std::forward<TRange>(range)), _skip(skip) {
+			}
+
+			constexpr Iterator begin() const { return bounded_advance(_range.begin(), _range.end(), _skip); }
+			constexpr auto end() const { return _range.end(); }
+
+			constexpr std::size_t size() const requires Sized<TRange>
+			{
+				std::size_t size = _range.size();
+				return size - clamp_count(_skip, size);
+			}
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const requires Pushable<TRange>
+			{
+				if constexpr (requires { slice(0, 0).push(sink); })
+				{
+					return slice(0, size()).push(sink);
+				}
+				else
+				{
+					TNumber skipped = static_cast<TNumber>(0);
+					return _range.push([&](auto&& item)
+					{
+						if (skipped < _skip)
+						{
+							++skipped;
+							return true;
+						}
+						return static_cast<bool>(sink(std::forward<decltype(item)>(item)));
+					});
+				}
+			}
+
+			constexpr std::size_t split_size() const requires Sized<TRange> && Splittable<TRange> { return size(); }
+			constexpr auto slice(std::size_t from, std::size_t to) const requires Sized<TRange> && Splittable<TRange>
+			{
+				std::size_t offset = clamp_count(_skip, _range.size());
+				return _range.slice(offset + from, offset + to);
+			}
+
+		private:
+			TRange _range;
+			TNumber _skip;
+		};
+
+		template <typename TRange, std::integral TNumber>
+		constexpr auto skip_impl(TRange&& range, TNumber skip)
+		{
+			return TSkip<TRange, TNumber>(std::forward<TRange>(range), skip);
+		}
+
+		// Over random-access upstreams take hands out upstream iterators and moves the
+		// end. Anywhere else finding that end would walk the elements an extra time, so
+		// iterators count down what is left and compare against the upstream's end.
+		template <class TRange, std::integral TNumber>
+		class TTake
+		{
+		public:
+			using It = iterator_t<TRange>;
+			static constexpr bool counted = !(RandomAccessIterator<It> && CommonRange<TRange>);
+
+			class CountedIterator
+			{
+			public:
+				static constexpr bool stashing = StashingIterator<It>;
+				using reference = decltype(*std::declval<It>());
+				using value_type = std::remove_cvref_t<reference>;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::conditional_t<BidirectionalIterator<It>, std::bidirectional_iterator_tag, std::forward_iterator_tag>;
+
+				constexpr CountedIterator(It it, TNumber left) : _it(it), _left(left) {}
+
+				constexpr reference operator*() const { return *_it; }
+				// Stays on the last element taken instead of moving the upstream past it,
+				// where e.g. a filter would go looking for a match nobody asked for
+				constexpr CountedIterator& operator++()
+				{
+					if (--_left > 0) ++_it;
+					return *this;
+				}
+				constexpr CountedIterator& operator--() requires BidirectionalIterator<It>
+				{
+					if (_left++ > 0) --_it;
+					return *this;
+				}
+				constexpr bool operator==(const CountedIterator& other) const { return _left == other._left; }
+				constexpr bool operator!=(const CountedIterator& other) const { return _left != other._left; }
+				constexpr bool operator==(const Sentinel<sentinel_t<TRange>>& end) const { return _left <= 0 || !(_it != end.end); }
+
+			private:
+				It _it;
+				TNumber _left;
+			};
+
+			using Iterator = std::conditional_t<counted, CountedIterator, It>;
+
+			constexpr TTake(TRange range, TNumber amount)
+				: _range(std::forward<TRange>(range)), _amount(amount) {
+			}
+
+			constexpr Iterator begin() const
+			{
+				if constexpr (counted) return CountedIterator(_range.begin(), _amount);
+				else return _range.begin();
+			}
+			constexpr auto end() const
+			{
+				if constexpr (counted) return Sentinel<sentinel_t<TRange>>{ _range.end() };
+				else return bounded_advance(_range.begin(), _range.end(), _amount);
+			}
+
+			constexpr std::size_t size() const requires Sized<TRange> { return clamp_count(_amount, _range.size()); }
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const requires Pushable<TRange>
+			{
+				if constexpr (requires { slice(0, 0).push(sink); })
+				{
+					return slice(0, size()).push(sink);
+				}
+				else
+				{
+					if (_amount <= 0) return true;
+					TNumber taken = static_cast<TNumber>(0);
+					bool stopped = false;
+					_range.push([&](auto&& item)
+					{
+						if (!sink(std::forward<decltype(item)>(item)))
+						{
+							stopped = true;
+							return false;
+						}
+						return ++taken < _amount;
+					});
+					return !stopped;
+				}
+			}
+
+			constexpr std::size_t split_size() const requires Sized<TRange> && Splittable<TRange> { return size(); }
+			constexpr auto slice(std::size_t from, std::size_t to) const requires Sized<TRange> && Splittable<TRange>
+			{
+				return _range.slice(from, to);
+			}
+
+		private:
+			TRange _range;
+			TNumber _amount;
+		};
+
+		template <typename TRange, std::integral TNumber>
+		constexpr auto take_impl(TRange&& range, TNumber amount)
+		{
+			return TTake<TRange, TNumber>(std::forward<TRange>(range), amount);
+		}
+
+		template <class TRange>
+		class TReverse
+		{
+		public:
+			// Like std::reverse_iterator, points one past the element it yields
+			class Iterator
+			{
+			public:
+				using It = iterator_t<TRange>;
+				using value_type = std::remove_cvref_t<decltype(*std::declval<It>())>;
+				// operator* dereferences a temporary copy of the upstream iterator
+				using reference = std::conditional_t<StashingIterator<It>, value_type, decltype(*std::declval<It>())>;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = iterator_category_t<It>;
+
+				constexpr Iterator(It it) : _it(it) {}
+
+				constexpr reference operator*() const
+				{
+					It prev = _it;
+					--prev;
+					return *prev;
+				}
+				constexpr Iterator& operator++() { --_it; return *this; }
+				constexpr Iterator& operator--() { ++_it; return *this; }
+				constexpr bool operator==(const Iterator& other) const { return !(_it != other._it); }
+				constexpr bool operator!=(const Iterator& other) const { return _it != other._it; }
+
+				constexpr Iterator& operator+=(difference_type n) requires RandomAccessIterator<It> { _it -= n; return *this; }
+				constexpr Iterator& operator-=(difference_type n) requires RandomAccessIterator<It> { _it += n; return *this; }
+				constexpr Iterator operator+(difference_type n) const requires RandomAccessIterator<It> { return Iterator(_it - n); }
+				constexpr Iterator operator-(difference_type n) const requires RandomAccessIterator<It> { return Iterator(_it + n); }
+				constexpr difference_type operator-(const Iterator& other) const requires RandomAccessIterator<It> { return other._it - _it; }
+				constexpr reference operator[](difference_type n) const requires RandomAccessIterator<It> { return *(*this + n); }
+				constexpr bool operator<(const Iterator& other) const requires RandomAccessIterator<It> { return other._it < _it; }
+
+			private:
+				It _it;
+			};
+
+			constexpr TReverse(TRange range) : _range(std::forward<TRange>(range)) {}
+
+			constexpr Iterator begin() const { return Iterator(end_iterator(_range)); }
+			constexpr Iterator end() const { return Iterator(_range.begin()); }
+
+			constexpr std::size_t size() const requires Sized<TRange> { return _range.size(); }
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const
+			{
+				auto first = _range.begin();
+				for (auto it = end_iterator(_range); it != first;)
+				{
+					--it;
+					if (!sink(*it)) return false;
+				}
+				return true;
+			}
+
+			constexpr std::size_t split_size() const requires Sized<TRange> && Splittable<TRange> { return size(); }
+			constexpr auto slice(std::size_t from, std::size_t to) const requires Sized<TRange> && Splittable<TRange>
+			{
+				std::size_t size = _range.size();
+				return TReverse<decltype(_range.slice(size - to, size - from))>(_range.slice(size - to, size - from));
+			}
+
+			constexpr const auto& base() const { return _range; }
+
+		private:
+			TRange _range;
+		};
+
+		template <typename TRange>
+		constexpr auto reverse_impl(TRange&& range)
+		{
+			return TReverse<TRange>(std::forward<TRange>(range));
+		}
+
+		// Remembers the value of the current element, so dereferencing it again does
+		// not run the upstream callbacks again
+		template <class TRange>
+		class TCache
+		{
+		public:
+			class Iterator
+			{
+			public:
+				using It = iterator_t<TRange>;
+				static constexpr bool stashing = true;
+				using value_type = std::remove_cvref_t<decltype(*std::declval<It>())>;
+				using reference = const value_type&;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = iterator_category_t<It>;
+
+				constexpr Iterator(It it) : _it(it) {}
+
+				constexpr reference operator*() const
+				{
+					if (!_cache) _cache.emplace(*_it);
+					return *_cache;
+				}
+				constexpr Iterator& operator++() { ++_it; _cache.reset(); return *this; }
+				constexpr Iterator& operator--() requires BidirectionalIterator<It> { --_it; _cache.reset(); return *this; }
+				constexpr bool operator==(const Iterator& other) const { return !(_it != other._it); }
+				constexpr bool operator!=(const Iterator& other) const { return _it != other._it; }
+				template <class End>
+				constexpr bool operator==(const Sentinel<End>& end) const { return !(_it != end.end); }
+
+				constexpr Iterator& operator+=(difference_type n) requires RandomAccessIterator<It> { _it += n; _cache.reset(); return *this; }
+				constexpr Iterator& operator-=(difference_type n) requires RandomAccessIterator<It> { _it -= n; _cache.reset(); return *this; }
+				constexpr Iterator operator+(difference_type n) const requires RandomAccessIterator<It> { return Iterator(_it + n); }
+				constexpr Iterator operator-(difference_type n) const requires RandomAccessIterator<It> { return Iterator(_it - n); }
+				constexpr difference_type operator-(const Iterator& other) const requires RandomAccessIterator<It> { return _it - other._it; }
+				constexpr value_type operator[](difference_type n) const requires RandomAccessIterator<It> { return *(_it + n); }
+				constexpr bool operator<(const Iterator& other) const requires RandomAccessIterator<It> { return _it < other._it; }
+
+			private:
+				It _it;
+				mutable std::optional<value_type> _cache;
+			};
+
+			constexpr TCache(TRange range) : _range(std::forward<TRange>(range)) {}
+
+			constexpr Iterator begin() const { return Iterator(_range.begin()); }
+			constexpr auto end() const
+			{
+				if constexpr (CommonRange<TRange>) return Iterator(_range.end());
+				else return Sentinel<sentinel_t<TRange>>{ _range.end() };
+			}
+
+			constexpr std::size_t size() const requires Sized<TRange> { return _range.size(); }
+
+			// Pushed values are only computed once anyway
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const requires Pushable<TRange> { return _range.push(sink); }
+
+			constexpr std::size_t split_size() const requires Splittable<TRange> { return _range.split_size(); }
+			constexpr auto slice(std::size_t from, std::size_t to) const requires Splittable<TRange>
+			{
+				return TCache<decltype(_range.slice(from, to))>(_range.slice(from, to));
+			}
+
+		private:
+			TRange _range;
+		};
+
+		template <typename TRange>
+		constexpr auto cache_impl(TRange&& range)
+		{
+			return TCache<TRange>(std::forward<TRange>(range));
+		}
+
+		// Ranges over contiguous chars, e.g. a std::string, a std::string_view or a mapped file
+		template <class T>
+		concept CharSource = std::contiguous_iterator<iterator_t<T>> && std::is_same_v<std::iter_value_t<iterator_t<T>>, char>;
+
+		// Cuts a char range into string_views at every delimiter without copying.
+		// Lines drops the empty piece after a trailing newline and a '\r' before
+		// each '\n', like std::getline on Windows-style files.
+		template <CharSource TRange, bool Lines>
+		class TSplit
+		{
+		public:
+			class Iterator
+			{
+			public:
+				using value_type = std::string_view;
+				using reference = std::string_view;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::forward_iterator_tag;
+
+				constexpr Iterator() = default;
+				constexpr Iterator(const char* pos, const char* end, char delim) : _pos(pos), _end(end), _delim(delim) { find(); }
+
+				constexpr std::string_view operator*() const
+				{
+					std::size_t size = static_cast<std::size_t>(_next - _pos);
+					if constexpr (Lines)
+					{
+						if (size != 0 && _pos[size - 1] == '\r') --size;
+					}
+					return std::string_view(_pos, size);
+				}
+				constexpr Iterator& operator++()
+				{
+					if (_next == _end || (Lines && _next + 1 == _end))
+						_pos = nullptr;
+					else
+					{
+						_pos = _next + 1;
+						find();
+					}
+					return *this;
+				}
+				constexpr Iterator operator++(int) { auto tmp = *this; ++(*this); return tmp; }
+				constexpr bool operator==(const Iterator& other) const { return _pos == other._pos; }
+				constexpr bool operator!=(const Iterator& other) const { return _pos != other._pos; }
+
+			private:
+				// Start of the current piece, nullptr once past the last one
+				const char* _pos = nullptr;
+				// Delimiter that ends the current piece, or _end
+				const char* _next = nullptr;
+				const char* _end = nullptr;
+				char _delim = 0;
+
+				constexpr void find()
+				{
+					if (!_pos) return;
+					if (std::is_constant_evaluated())
+					{
+						_next = _pos;
+						while (_next != _end && *_next != _delim) ++_next;
+					}
+					else
+						_next = simd::find_byte(_pos, _end, _delim);
+				}
+			};
+
+			constexpr TSplit(TRange range, char delim) : _range(std::forward<TRange>(range)), _delim(delim) {}
+
+			constexpr Iterator begin() const
+			{
+				auto first = _range.begin();
+				auto size = _range.end() - first;
+				if (size == 0) return end();
+				const char* data = std::to_address(first);
+				return Iterator(data, data + size, _delim);
+			}
+			constexpr Iterator end() const { return Iterator(); }
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const
+			{
+				for (Iterator it = begin(), last = end(); it != last; ++it)
+				{
+					if (!sink(*it)) return false;
+				}
+				return true;
+			}
+
+		private:
+			TRange _range;
+			char _delim;
+		};
+
+		template <bool Lines, typename TRange>
+		constexpr auto split_impl(TRange&& range, char delim)
+		{
+			return TSplit<TRange, Lines>(std::forward<TRange>(range), delim);
+		}
+
+		template <class T>
+		class TEnumerate
+		{
+		public:
+			class Iterator
+			{
+			public:
+				using reference = T;
+				using value_type = T;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::random_access_iterator_tag;
+
+				constexpr Iterator(T it) : _it(it) {}
+
+				constexpr T operator*() const { return _it; }
+				constexpr Iterator& operator++() { ++_it; return *this; }
+				constexpr Iterator& operator--() { --_it; return *this; }
+				constexpr bool operator==(const Iterator& other) const { return _it == other._it; }
+				constexpr bool operator!=(const Iterator& other) const { return _it != other._it; }
+
+				constexpr Iterator& operator+=(difference_type n) { _it = static_cast<T>(_it + n); return *this; }
+				constexpr Iterator& operator-=(difference_type n) { _it = static_cast<T>(_it - n); return *this; }
+				constexpr Iterator operator+(difference_type n) const { return Iterator(static_cast<T>(_it + n)); }
+				constexpr Iterator operator-(difference_type n) const { return Iterator(static_cast<T>(_it - n)); }
+				constexpr difference_type operator-(const Iterator& other) const
+				{
+					return static_cast<difference_type>(_it) - static_cast<difference_type>(other._it);
+				}
+				constexpr T operator[](difference_type n) const { return static_cast<T>(_it + n); }
+				constexpr bool operator<(const Iterator& other) const { return _it < other._it; }
+
+			private:
+				T _it;
+			};
+
+			constexpr TEnumerate(T min_, T max_)
+				: _min(min_), _max(max_) {
+			}
+
+			constexpr Iterator begin() const { return Iterator(_min); }
+			constexpr Iterator end() const { return Iterator(_max); }
+
+			constexpr std::size_t size() const { return _max > _min ? static_cast<std::size_t>(_max - _min) : 0; }
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const
+			{
+				for (T i = _min; i < _max; ++i)
+				{
+					if (!sink(i)) return false;
+				}
+				return true;
+			}
+
+			constexpr std::size_t split_size() const { return size(); }
+			constexpr TEnumerate slice(std::size_t from, std::size_t to) const
+			{
+				return TEnumerate(static_cast<T>(_min + static_cast<T>(from)), static_cast<T>(_min + static_cast<T>(to)));
+			}
+
+		private:
+			T _min;
+			T _max;
+		};
+
+		// The interval of integers a range yields, for terminals that do not care about
+		// order: range(from, count), possibly reversed or cut by skip and take. Lets
+		// them compute the answer instead of walking the values.
+		template <class T>
+		constexpr TEnumerate<T> values_of(const TEnumerate<T>& range) { return range; }
+
+		template <class TRange>
+		constexpr auto values_of(const TReverse<TRange>& range) -> decltype(values_of(range.base())) { return values_of(range.base()); }
+
+		template <class TRange, class TNumber>
+			requires Sized<TRange> && Splittable<TRange>
+		constexpr auto values_of(const TSkip<TRange, TNumber>& range) -> decltype(values_of(range.slice(0, 0))) { return values_of(range.slice(0, range.size())); }
+
+		template <class TRange, class TNumber>
+			requires Sized<TRange> && Splittable<TRange>
+		constexpr auto values_of(const TTake<TRange, TNumber>& range) -> decltype(values_of(range.slice(0, 0))) { return values_of(range.slice(0, range.size())); }
+
+		template <class T>
+		concept Enumerated = requires(const std::remove_cvref_t<T>& range) { values_of(range); };
+
+		template <class TRange, class Func>
+		concept EnumeratedCompare = Enumerated<TRange> && IsComparePredicate<std::remove_cvref_t<Func>>::value;
+
+		// How many values of an interval pass a compare predicate. Each compare holds on
+		// a prefix, a suffix or a middle part of increasing values, found by binary search.
+		template <class T, simd::Compare Op, class U>
+		constexpr std::size_t enumerated_count(const TEnumerate<T>& values, const ComparePredicate<Op, U>& pred)
+		{
+			using enum simd::Compare;
+			auto first = values.begin();
+			std::size_t size = values.size();
+			// Index of the first value for which test holds, test must hold on a suffix
+			auto partition = [&](auto&& test)
+			{
+				std::size_t lo = 0, hi = size;
+				while (lo < hi)
+				{
+					std::size_t mid = lo + (hi - lo) / 2;
+					if (test(first[static_cast<std::ptrdiff_t>(mid)])) hi = mid;
+					else lo = mid + 1;
+				}
+				return lo;
+			};
+			auto at_least = [&](const U& bound) { return partition([&](T x) { return simd::compare<GreaterEqual>(x, bound, bound); }); };
+			auto above = [&](const U& bound) { return partition([&](T x) { return simd::compare<Greater>(x, bound, bound); }); };
+
+			if constexpr (Op == Less) return at_least(pred.a);
+			else if constexpr (Op == LessEqual) return above(pred.a);
+			else if constexpr (Op == Greater) return size - above(pred.a);
+			else if constexpr (Op == GreaterEqual) return size - at_least(pred.a);
+			else
+			{
+				const U& hi = Op == Between ? pred.b : pred.a;
+				std::size_t from = at_least(pred.a), to = above(hi);
+				std::size_t inside = to > from ? to - from : 0;
+				return Op == NotEqual ? size - inside : inside;
+			}
+		}
+
+		// Sum of count consecutive integers starting at first. Wraps around like the loop
+		// it replaces, the arithmetic is done modulo 2^64 and truncated.
+		template <std::integral T>
+		constexpr T arithmetic_series_sum(T first, std::size_t count)
+		{
+			std::uint64_t n = count;
+			std::uint64_t triangle = n % 2 == 0 ? (n / 2) * (n - 1) : n * ((n - 1) / 2);
+			std::uint64_t total = n * static_cast<std::uint64_t>(first) + triangle;
+			return static_cast<T>(static_cast<std::make_unsigned_t<T>>(total));
+		}
+
+		template <class T>
+		concept Arithmetic = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+		// Pipelines whose values can be produced a block at a time into contiguous
+		// memory: a contiguous source of numbers, possibly behind a chain of maps.
+		template <class T>
+		struct BlockTraits
+		{
+			static constexpr bool value = false;
+		};
+
+		template <class TIterator, class TOwner>
+			requires std::contiguous_iterator<TIterator> && Arithmetic<std::iter_value_t<TIterator>>
+		struct BlockTraits<TRange<TIterator, TOwner>>
+		{
+			static constexpr bool value = true;
+			using type = std::iter_value_t<TIterator>;
+		};
+
+		template <class TRange, class Func>
+			requires BlockTraits<std::remove_cvref_t<TRange>>::value
+				&& Arithmetic<std::remove_cvref_t<std::invoke_result_t<const Func&, const typename BlockTraits<std::remove_cvref_t<TRange>>::type&>>>
+		struct BlockTraits<TMap<TRange, Func>>
+		{
+			static constexpr bool value = true;
+			using type = std::remove_cvref_t<std::invoke_result_t<const Func&, const typename BlockTraits<std::remove_cvref_t<TRange>>::type&>>;
+		};
+
+		template <class T>
+		concept BlockSource = BlockTraits<std::remove_cvref_t<T>>::value;
+
+		template <BlockSource T>
+		using block_value_t = typename BlockTraits<std::remove_cvref_t<T>>::type;
+
+		template <class T>
+		concept IntegralBlockSource = BlockSource<T> && std::is_integral_v<block_value_t<T>>;
+
+		constexpr std::size_t block_buffer_size = 256;
+
+		// Calls fn(const T* data, std::size_t size) for consecutive blocks of the range.
+		// fn may return false to stop, which is then returned from here as well.
+		template <BlockSource TRange, class Func>
+		bool for_each_block(const TRange& range, Func&& fn)
+		{
+			using T = block_value_t<TRange>;
+			auto call = [&](const T* data, std::size_t size)
+			{
+				if constexpr (std::is_void_v<std::invoke_result_t<Func&, const T*, std::size_t>>)
+				{
+					fn(data, size);
+					return true;
+				}
+				else
+					return static_cast<bool>(fn(data, size));
+			};
+
+			if constexpr (requires { range.base(); })
+			{
+				T buffer[block_buffer_size];
+				return for_each_block(range.base(), [&](const auto* data, std::size_t size)
+				{
+					for (std::size_t i = 0; i < size; i += block_buffer_size)
+					{
+						std::size_t n = std::min(block_buffer_size, size - i);
+						for (std::size_t j = 0; j < n; ++j)
+							buffer[j] = range.function()(data[i + j]);
+						if (!call(buffer, n)) return false;
+					}
+					return true;
+				});
+			}
+			else
+			{
+				return call(std::to_address(range.begin()), static_cast<std::size_t>(range.end() - range.begin()));
+			}
+		}
+
+		template <class TRange, class Func>
+		concept SimdFilterable = BlockSource<TRange> && IsComparePredicate<Func>::value && simd::Vectorizable<block_value_t<TRange>>;
+
+		// Converts a compare bound to the element type T when comparing in T answers the
+		// same as the scalar compare, which works in the common type of T and the bound.
+		// Fractional, out-of-range or inexact bounds (lt(2.5) or lt(5'000'000'000) over
+		// int) return false and keep the scalar loop.
+		template <class T, class U>
+		constexpr bool exact_bound(const U& bound, T& out)
+		{
+			if constexpr (!std::is_arithmetic_v<U> || std::is_same_v<U, bool>) return false;
+			else
+			{
+				using C = std::common_type_t<T, U>;
+				if constexpr (std::is_same_v<C, T>)
+				{
+					out = static_cast<T>(bound);
+					return true;
+				}
+				else
+				{
+					// Elements are widened to C by the scalar compare, which has to keep their order
+					// and tell them apart for a compare in T to agree with it
+					constexpr bool widens = std::is_floating_point_v<C>
+						? std::numeric_limits<C>::digits >= std::numeric_limits<T>::digits
+						: std::is_signed_v<C> && sizeof(C) >= sizeof(T);
+					if constexpr (!widens) return false;
+					else
+					{
+						auto value = static_cast<C>(bound);
+						if (!(value >= static_cast<C>(std::numeric_limits<T>::lowest()) && value <= static_cast<C>(std::numeric_limits<T>::max()))) return false;
+						out = static_cast<T>(value);
+						return static_cast<C>(out) == value;
+					}
+				}
+			}
+		}
+
+		template <class TRange, class Func, class Sink>
+		constexpr bool filter_push(const TRange& range, const Func& func, Sink& sink)
+		{
+			if constexpr (SimdFilterable<TRange, Func>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					// Matches of each block are collected into a selection vector first, so
+					// the loop feeding the sink only runs over survivors
+					using T = block_value_t<TRange>;
+					T a{}, b{};
+					if (exact_bound(func.a, a) && exact_bound(func.b, b))
+					{
+						std::uint32_t selection[block_buffer_size];
+						return for_each_block(range, [&](const T* data, std::size_t size)
+						{
+							for (std::size_t i = 0; i < size; i += block_buffer_size)
+							{
+								std::size_t n = std::min(block_buffer_size, size - i);
+								std::size_t selected = simd::select<Func::op>(data + i, n, a, b, selection);
+								for (std::size_t k = 0; k < selected; ++k)
+								{
+									if (!sink(data[i + selection[k]])) return false;
+								}
+							}
+							return true;
+						});
+					}
+				}
+			}
+			return range.push([&](auto&& item) { return !func(item) || sink(std::forward<decltype(item)>(item)); });
+		}
+
+		template <BlockSource TRange>
+		auto block_sum(const TRange& range)
+		{
+			auto sum = static_cast<block_value_t<TRange>>(0);
+			for_each_block(range, [&](const auto* data, std::size_t size) { sum += simd::sum(data, size); });
+			return sum;
+		}
+
+		// Calls fn(item) for every element until it returns false, pushing through the
+		// pipeline when possible and pulling through its iterators otherwise.
+		// Returns false if fn stopped the walk.
+		template <typename TRange, typename Func>
+		constexpr bool drive(TRange&& range, Func&& fn)
+		{
+			if constexpr (Pushable<TRange>)
+				return range.push(fn);
+			else
+			{
+				for (auto&& item : range)
+				{
+					if (!fn(item)) return false;
+				}
+				return true;
+			}
+		}
+
+		// Runs a range on its own thread and hands its elements over in batches.
+		// Filled batches go through one ring and emptied ones come back through
+		// another, so a steady stream does not allocate. The worker is a dedicated
+		// thread rather than a pool task because it blocks for the whole walk.
+		template <class TRange>
+		class BufferedChannel
+		{
+		public:
+			using value_type = std::remove_cvref_t<decltype(*std::declval<iterator_t<TRange>>())>;
+			using Batch = std::vector<value_type>;
+			// The worker gets its own copy of the upstream. Move-only ones (with move-only
+			// callables) are reached through the stage instead, which outlives its iterators.
+			using Source = std::conditional_t<std::copy_constructible<TRange>, TRange, const TRange*>;
+
+			BufferedChannel(Source range, std::size_t capacity)
+				: _batch_size(std::max<std::size_t>(capacity / ring_batches, 1)), _full(ring_batches), _free(ring_batches)
+			{
+				_worker = std::thread([this, r = std::move(range)]() mutable
+				{
+					if constexpr (std::is_pointer_v<Source>) produce(*r);
+					else produce(r);
+				});
+			}
+
+			BufferedChannel(const BufferedChannel&) = delete;
+			BufferedChannel& operator=(const BufferedChannel&) = delete;
+
+			~BufferedChannel()
+			{
+				_stop.store(true, std::memory_order_relaxed);
+				if (_worker.joinable()) _worker.join();
+			}
+
+			// Blocks until there is a current element or the upstream is exhausted
+			bool at_end()
+			{
+				return _index == _current.size() && !fetch();
+			}
+			value_type& current() { return _current[_index]; }
+			void advance() { ++_index; }
+
+		private:
+			static constexpr std::size_t ring_batches = 4;
+
+			std::size_t _batch_size;
+			SpscRing<Batch> _full;
+			SpscRing<Batch> _free;
+			std::atomic<bool> _stop{ false };
+			std::atomic<bool> _done{ false };
+			std::exception_ptr _error;
+			std::thread _worker;
+
+			// Consumer state
+			Batch _current;
+			std::size_t _index = 0;
+			bool _finished = false;
+
+			static void backoff(unsigned& spins)
+			{
+				if (++spins > 64) std::this_thread::yield();
+			}
+
+			void produce(const TRange& range)
+			{
+				try
+				{
+					Batch batch = take_free();
+					drive(range, [&](auto&& item)
+					{
+						batch.emplace_back(std::forward<decltype(item)>(item));
+						if (batch.size() == _batch_size)
+						{
+							if (!send(batch)) return false;
+							batch = take_free();
+						}
+						return !_stop.load(std::memory_order_relaxed);
+					});
+					if (!batch.empty()) send(batch);
+				}
+				catch (...)
+				{
+					_error = std::current_exception();
+				}
+				_done.store(true, std::memory_order_release);
+			}
+
+			Batch take_free()
+			{
+				Batch batch;
+				if (!_free.try_pop(batch)) batch.reserve(_batch_size);
+				return batch;
+			}
+
+			// Waits while the consumer is behind, which is the backpressure
+			bool send(Batch& batch)
+			{
+				for (unsigned spins = 0; !_full.try_push(std::move(batch)); backoff(spins))
+				{
+					if (_stop.load(std::memory_order_relaxed)) return false;
+				}
+				return true;
+			}
+
+			bool fetch()
+			{
+				if (_finished) return false;
+				_current.clear();
+				_index = 0;
+				// Give the storage back; if the ring is full the batch is simply freed
+				_free.try_push(std::move(_current));
+				_current.clear();
+
+				for (unsigned spins = 0;; backoff(spins))
+				{
+					if (_full.try_pop(_current)) return true;
+					if (_done.load(std::memory_order_acquire))
+					{
+						if (_full.try_pop(_current)) return true;
+						_finished = true;
+						_worker.join();
+						if (_error) std::rethrow_exception(std::exchange(_error, nullptr));
+						return false;
+					}
+				}
+			}
+		};
+
+		template <class TRange>
+		class TBuffered
+		{
+		public:
+			using Channel = BufferedChannel<std::remove_cvref_t<TRange>>;
+
+			// Single pass: copies of an iterator share the channel and its position
+			class Iterator
+			{
+			public:
+				using value_type = typename Channel::value_type;
+				using reference = value_type&;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::input_iterator_tag;
+
+				Iterator() = default;
+				explicit Iterator(std::shared_ptr<Channel> channel) : _channel(std::move(channel)) {}
+
+				reference operator*() const { _channel->at_end(); return _channel->current(); }
+				Iterator& operator++() { _channel->advance(); return *this; }
+				bool operator==(const Iterator& other) const { return done() == other.done(); }
+				bool operator!=(const Iterator& other) const { return done() != other.done(); }
+
+			private:
+				std::shared_ptr<Channel> _channel;
+
+				bool done() const { return !_channel || _channel->at_end(); }
+			};
+
+			TBuffered(TRange range, std::size_t capacity) : _range(std::forward<TRange>(range)), _capacity(std::max<std::size_t>(capacity, 1)) {}
+
+			// Starts the upstream thread
+			Iterator begin() const { return Iterator(std::make_shared<Channel>(source(), _capacity)); }
+			Iterator end() const { return Iterator(); }
+
+			std::size_t size() const requires Sized<TRange> { return _range.size(); }
+
+			template <class Sink>
+			bool push(Sink&& sink) const
+			{
+				Channel channel(source(), _capacity);
+				while (!channel.at_end())
+				{
+					if (!sink(std::move(channel.current()))) return false;
+					channel.advance();
+				}
+				return true;
+			}
+
+		private:
+			TRange _range;
+			std::size_t _capacity;
+
+			typename Channel::Source source() const
+			{
+				if constexpr (std::is_pointer_v<typename Channel::Source>) return &_range;
+				else return _range;
+			}
+		};
+
+		template <typename TRange>
+		auto buffered_impl(TRange&& range, std::size_t capacity)
+		{
+			return TBuffered<TRange>(std::forward<TRange>(range), capacity);
+		}
+
+		// Yields std::span<const T> of up to n elements. Contiguous sources are
+		// viewed in place; anything else is copied through a buffer of n elements.
+		template <class TRange>
+		class TChunk
+		{
+		public:
+			using It = iterator_t<TRange>;
+			using End = sentinel_t<TRange>;
+			using value_type = std::remove_cvref_t<decltype(*std::declval<It>())>;
+			static constexpr bool contiguous = std::contiguous_iterator<It>;
+
+			class Iterator
+			{
+			public:
+				static constexpr bool stashing = !contiguous;
+				using value_type = std::span<const TChunk::value_type>;
+				using reference = value_type;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::forward_iterator_tag;
+
+				constexpr Iterator(It it, End end, std::size_t n) : _it(it), _end(end), _n(n) { fill(); }
+
+				constexpr value_type operator*() const
+				{
+					if constexpr (contiguous)
+						return value_type(std::to_address(_it), static_cast<std::size_t>(std::min<std::ptrdiff_t>(_end - _it, static_cast<std::ptrdiff_t>(_n))));
+					else
+						return value_type(_buffer);
+				}
+				constexpr Iterator& operator++()
+				{
+					if constexpr (contiguous)
+						_it = bounded_advance(_it, _end, _n);
+					else
+						fill();
+					return *this;
+				}
+				constexpr bool operator==(const Iterator& other) const { return !(*this != other); }
+				constexpr bool operator!=(const Iterator& other) const
+				{
+					if constexpr (contiguous)
+						return _it != other._it;
+					else
+						return _it != other._it || _buffer.empty() != other._buffer.empty();
+				}
+				constexpr bool operator==(std::default_sentinel_t) const requires (!contiguous) { return _buffer.empty(); }
+
+			private:
+				It _it;
+				End _end;
+				std::size_t _n;
+				[[no_unique_address]] std::conditional_t<contiguous, Empty, std::vector<TChunk::value_type>> _buffer;
+
+				constexpr void fill()
+				{
+					if constexpr (!contiguous)
+					{
+						_buffer.clear();
+						for (; _it != _end && _buffer.size() < _n; ++_it)
+							_buffer.push_back(*_it);
+					}
+				}
+			};
+
+			constexpr TChunk(TRange range, std::size_t n) : _range(std::forward<TRange>(range)), _n(std::max<std::size_t>(n, 1)) {}
+
+			constexpr Iterator begin() const { return Iterator(_range.begin(), _range.end(), _n); }
+			constexpr auto end() const
+			{
+				if constexpr (CommonRange<TRange>) return Iterator(_range.end(), _range.end(), _n);
+				else return std::default_sentinel;
+			}
+
+			constexpr std::size_t size() const requires Sized<TRange> { return (_range.size() + _n - 1) / _n; }
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const
+			{
+				if constexpr (contiguous)
+				{
+					for (Iterator it = begin(), last = end(); it != last; ++it)
+					{
+						if (!sink(*it)) return false;
+					}
+					return true;
+				}
+				else
+				{
+					std::vector<value_type> buffer;
+					buffer.reserve(_n);
+					bool stopped = !drive(_range, [&](auto&& item)
+					{
+						buffer.emplace_back(std::forward<decltype(item)>(item));
+						if (buffer.size() < _n) return true;
+						bool more = sink(std::span<const value_type>(buffer));
+						buffer.clear();
+						return more;
+					});
+					if (stopped) return false;
+					return buffer.empty() || sink(std::span<const value_type>(buffer));
+				}
+			}
+
+			// Chunk i of a slice is chunk from + i of the whole range
+			constexpr std::size_t split_size() const requires Splittable<TRange> && Sized<TRange> { return size(); }
+			constexpr auto slice(std::size_t from, std::size_t to) const requires Splittable<TRange> && Sized<TRange>
+			{
+				std::size_t total = _range.size();
+				return TChunk<decltype(_range.slice(0, 0))>(_range.slice(std::min(from * _n, total), std::min(to * _n, total)), _n);
+			}
+
+			constexpr const auto& base() const { return _range; }
+
+		private:
+			TRange _range;
+			std::size_t _n;
+		};
+
+		template <typename TRange>
+		constexpr auto chunk_impl(TRange&& range, std::size_t n)
+		{
+			return TChunk<TRange>(std::forward<TRange>(range), n);
+		}
+
+		// Yields std::span<const T> of every w consecutive elements, viewed in place
+		template <class TRange>
+		class TWindow
+		{
+		public:
+			using It = iterator_t<TRange>;
+			using value_type = std::remove_cvref_t<decltype(*std::declval<It>())>;
+			static_assert(std::contiguous_iterator<It> && CommonRange<TRange>, "window needs a contiguous source, the rolling stages take any range");
+
+			class Iterator
+			{
+			public:
+				using value_type = std::span<const TWindow::value_type>;
+				using reference = value_type;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::random_access_iterator_tag;
+
+				constexpr Iterator(const TWindow::value_type* data, std::size_t w) : _data(data), _w(w) {}
+
+				constexpr reference operator*() const { return value_type(_data, _w); }
+				constexpr Iterator& operator++() { ++_data; return *this; }
+				constexpr Iterator& operator--() { --_data; return *this; }
+				constexpr bool operator==(const Iterator& other) const { return _data == other._data; }
+				constexpr bool operator!=(const Iterator& other) const { return _data != other._data; }
+
+				constexpr Iterator& operator+=(difference_type n) { _data += n; return *this; }
+				constexpr Iterator& operator-=(difference_type n) { _data -= n; return *this; }
+				constexpr Iterator operator+(difference_type n) const { return Iterator(_data + n, _w); }
+				constexpr Iterator operator-(difference_type n) const { return Iterator(_data - n, _w); }
+				constexpr difference_type operator-(const Iterator& other) const { return _data - other._data; }
+				constexpr reference operator[](difference_type n) const { return value_type(_data + n, _w); }
+				constexpr bool operator<(const Iterator& other) const { return _data < other._data; }
+
+			private:
+				const TWindow::value_type* _data;
+				std::size_t _w;
+			};
+
+			constexpr TWindow(TRange range, std::size_t w) : _range(std::forward<TRange>(range)), _w(std::max<std::size_t>(w, 1)) {}
+
+			constexpr Iterator begin() const { return Iterator(std::to_address(_range.begin()), _w); }
+			constexpr Iterator end() const { return begin() + static_cast<std::ptrdiff_t>(size()); }
+
+			constexpr std::size_t size() const
+			{
+				auto n = static_cast<std::size_t>(_range.end() - _range.begin());
+				return n >= _w ? n - _w + 1 : 0;
+			}
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const
+			{
+				for (Iterator it = begin(), last = end(); it != last; ++it)
+				{
+					if (!sink(*it)) return false;
+				}
+				return true;
+			}
+
+			// Windows from..to of the whole range cover elements from..to + w - 1
+			constexpr std::size_t split_size() const requires Splittable<TRange> { return size(); }
+			constexpr auto slice(std::size_t from, std::size_t to) const requires Splittable<TRange>
+			{
+				std::size_t last = to > from ? to + _w - 1 : from;
+				return TWindow<decltype(_range.slice(from, last))>(_range.slice(from, last), _w);
+			}
+
+		private:
+			TRange _range;
+			std::size_t _w;
+		};
+
+		template <typename TRange>
+		constexpr auto window_impl(TRange&& range, std::size_t w)
+		{
+			return TWindow<TRange>(std::forward<TRange>(range), w);
+		}
+
+		// Double-ended queue over a ring of fixed capacity: N, or set at construction if N is 0
+		template <class T, std::size_t N>
+		class WindowDeque
+		{
+		public:
+			constexpr explicit WindowDeque(std::size_t capacity)
+			{
+				if constexpr (N == 0) _slots.resize(capacity);
+			}
+
+			constexpr std::size_t size() const { return _size; }
+			constexpr bool empty() const { return _size == 0; }
+			constexpr bool full() const { return _size == _slots.size(); }
+
+			constexpr const T& front() const { return _slots[_head]; }
+			constexpr const T& back() const { return _slots[wrap(_head + _size - 1)]; }
+
+			constexpr void push_back(const T& value)
+			{
+				_slots[wrap(_head + _size)] = value;
+				++_size;
+			}
+			constexpr void pop_front()
+			{
+				_head = wrap(_head + 1);
+				--_size;
+			}
+			constexpr void pop_back() { --_size; }
+
+		private:
+			std::conditional_t<N == 0, std::vector<T>, std::array<T, N>> _slots{};
+			std::size_t _head = 0;
+			std::size_t _size = 0;
+
+			constexpr std::size_t wrap(std::size_t index) const { return index < _slots.size() ? index : index - _slots.size(); }
+		};
+
+		// Rolling kernels see the elements one by one through push(x) and report the
+		// aggregate of the last w once ready()
+
+		// Adds the newest element and subtracts the one leaving the window, so floating
+		// point results can drift from a fresh sum by rounding
+		template <class T, std::size_t N, bool Mean>
+		class RollingSumKernel
+		{
+		public:
+			using value_type = std::conditional_t<Mean && !std::is_floating_point_v<T>, double, T>;
+
+			constexpr explicit RollingSumKernel(std::size_t w) : _last(w) {}
+
+			constexpr void push(const T& x)
+			{
+				if (_last.full())
+				{
+					_sum -= _last.front();
+					_last.pop_front();
+				}
+				_last.push_back(x);
+				_sum += x;
+			}
+			constexpr bool ready() const { return _last.full(); }
+			constexpr value_type value() const
+			{
+				if constexpr (Mean) return static_cast<value_type>(_sum) / static_cast<value_type>(_last.size());
+				else return _sum;
+			}
+
+		private:
+			WindowDeque<T, N> _last;
+			T _sum{};
+		};
+
+		// Monotonic deque: keeps only the elements that can still become the extreme,
+		// i.e. those with nothing better after them, so the front is the answer and
+		// every element enters and leaves once
+		template <class T, std::size_t N, bool Max>
+		class RollingExtremeKernel
+		{
+		public:
+			using value_type = T;
+
+			constexpr explicit RollingExtremeKernel(std::size_t w) : _w(w), _candidates(w) {}
+
+			constexpr void push(const T& x)
+			{
+				if (!_candidates.empty() && _candidates.front().first + _w <= _index) _candidates.pop_front();
+				while (!_candidates.empty() && !better(_candidates.back().second, x)) _candidates.pop_back();
+				_candidates.push_back({ _index++, x });
+			}
+			constexpr bool ready() const { return _index >= _w; }
+			constexpr value_type value() const { return _candidates.front().second; }
+
+		private:
+			std::size_t _w;
+			std::size_t _index = 0;
+			WindowDeque<std::pair<std::size_t, T>, N> _candidates;
+
+			static constexpr bool better(const T& a, const T& b) { return Max ? b < a : a < b; }
+		};
+
+		template <class T, std::size_t N> using RollingSum = RollingSumKernel<T, N, false>;
+		template <class T, std::size_t N> using RollingMean = RollingSumKernel<T, N, true>;
+		template <class T, std::size_t N> using RollingMin = RollingExtremeKernel<T, N, false>;
+		template <class T, std::size_t N> using RollingMax = RollingExtremeKernel<T, N, true>;
+
+		// Yields Kernel's aggregate of every w consecutive elements, n - w + 1 values in all
+		template <class TRange, class Kernel>
+		class TRolling
+		{
+		public:
+			using It = iterator_t<TRange>;
+			using End = sentinel_t<TRange>;
+			using value_type = typename Kernel::value_type;
+
+			class Iterator
+			{
+			public:
+				using value_type = TRolling::value_type;
+				using reference = value_type;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::forward_iterator_tag;
+
+				constexpr Iterator(It it, End end, std::size_t w) : _it(it), _end(end), _kernel(w)
+				{
+					for (; !_kernel.ready() && _it != _end; ++_it) _kernel.push(*_it);
+					_done = !_kernel.ready();
+				}
+
+				constexpr reference operator*() const { return _kernel.value(); }
+				constexpr Iterator& operator++()
+				{
+					if (_it != _end)
+					{
+						_kernel.push(*_it);
+						++_it;
+					}
+					else _done = true;
+					return *this;
+				}
+				constexpr bool operator==(const Iterator& other) const { return _done == other._done && !(_it != other._it); }
+				constexpr bool operator!=(const Iterator& other) const { return !(*this == other); }
+				constexpr bool operator==(std::default_sentinel_t) const { return _done; }
+
+			private:
+				It _it;
+				End _end;
+				Kernel _kernel;
+				bool _done;
+			};
+
+			constexpr TRolling(TRange range, std::size_t w) : _range(std::forward<TRange>(range)), _w(std::max<std::size_t>(w, 1)) {}
+
+			constexpr Iterator begin() const { return Iterator(_range.begin(), _range.end(), _w); }
+			// An end iterator would need a kernel of its own
+			constexpr std::default_sentinel_t end() const { return std::default_sentinel; }
+
+			constexpr std::size_t size() const requires Sized<TRange>
+			{
+				std::size_t n = _range.size();
+				return n >= _w ? n - _w + 1 : 0;
+			}
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const
+			{
+				Kernel kernel(_w);
+				return drive(_range, [&](auto&& item)
+				{
+					kernel.push(item);
+					return !kernel.ready() || static_cast<bool>(sink(kernel.value()));
+				});
+			}
+
+			// Values from..to of the whole range come from elements from..to + w - 1
+			constexpr std::size_t split_size() const requires Sized<TRange> && Splittable<TRange> { return size(); }
+			constexpr auto slice(std::size_t from, std::size_t to) const requires Sized<TRange> && Splittable<TRange>
+			{
+				std::size_t last = to > from ? to + _w - 1 : from;
+				return TRolling<decltype(_range.slice(from, last)), Kernel>(_range.slice(from, last), _w);
+			}
+
+		private:
+			TRange _range;
+			std::size_t _w;
+		};
+
+		template <template <class, std::size_t> class Kernel, std::size_t N, typename TRange>
+		constexpr auto rolling_impl(TRange&& range, std::size_t w)
+		{
+			using T = std::remove_cvref_t<decltype(*std::declval<iterator_t<TRange>>())>;
+			return TRolling<TRange, Kernel<T, N>>(std::forward<TRange>(range), N == 0 ? w : N);
+		}
+
+		// Running fold op(...op(op(init, x0), x1)..., xi). Inclusive scans yield it for
+		// every element i, exclusive ones the fold before element i, starting with init.
+		template <class TRange, class Op, class T, bool Exclusive>
+		class TScan
+		{
+		public:
+			using It = iterator_t<TRange>;
+			using End = sentinel_t<TRange>;
+
+			class Iterator
+			{
+			public:
+				using value_type = T;
+				using reference = T;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::forward_iterator_tag;
+
+				constexpr Iterator(It it, End end, T init, FuncRef<Op> op) : _it(it), _end(end), _acc(std::move(init)), _op(op)
+				{
+					if constexpr (!Exclusive)
+					{
+						if (_it != _end) _acc = _op(std::move(_acc), *_it);
+					}
+				}
+
+				constexpr reference operator*() const { return _acc; }
+				constexpr Iterator& operator++()
+				{
+					if constexpr (Exclusive)
+					{
+						_acc = _op(std::move(_acc), *_it);
+						++_it;
+					}
+					else
+					{
+						++_it;
+						if (_it != _end) _acc = _op(std::move(_acc), *_it);
+					}
+					return *this;
+				}
+				constexpr bool operator==(const Iterator& other) const { return !(_it != other._it); }
+				constexpr bool operator!=(const Iterator& other) const { return _it != other._it; }
+				constexpr bool operator==(std::default_sentinel_t) const { return !(_it != _end); }
+
+			private:
+				It _it;
+				End _end;
+				T _acc;
+				[[no_unique_address]] FuncRef<Op> _op;
+			};
+
+			constexpr TScan(TRange range, Op op, T init)
+				: _range(std::forward<TRange>(range)), _op(std::move(op)), _init(std::move(init)) {
+			}
+
+			constexpr Iterator begin() const { return Iterator(_range.begin(), _range.end(), _init, _op); }
+			constexpr auto end() const
+			{
+				if constexpr (CommonRange<TRange>) return Iterator(_range.end(), _range.end(), _init, _op);
+				else return std::default_sentinel;
+			}
+
+			constexpr std::size_t size() const requires Sized<TRange> { return _range.size(); }
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const
+			{
+				T acc = _init;
+				return drive(_range, [&](auto&& item)
+				{
+					if constexpr (Exclusive)
+					{
+						if (!sink(std::as_const(acc))) return false;
+						acc = _op(std::move(acc), std::forward<decltype(item)>(item));
+						return true;
+					}
+					else
+					{
+						acc = _op(std::move(acc), std::forward<decltype(item)>(item));
+						return static_cast<bool>(sink(std::as_const(acc)));
+					}
+				});
+			}
+
+		private:
+			TRange _range;
+			[[no_unique_address]] Op _op;
+			T _init;
+		};
+
+		template <bool Exclusive, typename TRange, class Op, class T>
+		constexpr auto scan_impl(TRange&& range, Op op, T init)
+		{
+			return TScan<TRange, Op, T, Exclusive>(std::forward<TRange>(range), std::move(op), std::move(init));
+		}
+
+		// Element-wise map done a batch at a time: func(std::span<const T> in,
+		// std::span<U> out) fills out[i] from in[i], so it can use its own SIMD code.
+		template <class TRange, class U, class Func>
+		class TMapBatch
+		{
+		public:
+			using Chunks = TChunk<std::remove_cvref_t<TRange>>;
+
+			class Iterator
+			{
+			public:
+				static constexpr bool stashing = true;
+				using value_type = U;
+				using reference = const U&;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::forward_iterator_tag;
+
+				constexpr Iterator(typename Chunks::Iterator chunk, sentinel_t<Chunks> end, FuncRef<Func> func)
+					: _chunk(std::move(chunk)), _end(std::move(end)), _func(func) { load(); }
+
+				constexpr reference operator*() const { return _out[_index]; }
+				constexpr Iterator& operator++()
+				{
+					if (++_index == _out.size())
+					{
+						++_chunk;
+						load();
+					}
+					return *this;
+				}
+				constexpr bool operator==(const Iterator& other) const { return !(*this != other); }
+				constexpr bool operator!=(const Iterator& other) const { return _chunk != other._chunk || _index != other._index; }
+				// Chunks are never empty, so only the end leaves nothing to hand out
+				constexpr bool operator==(std::default_sentinel_t) const { return _out.empty(); }
+
+			private:
+				typename Chunks::Iterator _chunk;
+				sentinel_t<Chunks> _end;
+				[[no_unique_address]] FuncRef<Func> _func;
+				std::vector<U> _out;
+				std::size_t _index = 0;
+
+				constexpr void load()
+				{
+					_index = 0;
+					_out.clear();
+					if (_chunk == _end) return;
+					auto in = *_chunk;
+					_out.resize(in.size());
+					_func(in, std::span<U>(_out));
+				}
+			};
+
+			constexpr TMapBatch(TRange range, Func func, std::size_t batch)
+				: _chunks(std::forward<TRange>(range), batch), _func(std::move(func)), _batch(std::max<std::size_t>(batch, 1)) {
+			}
+
+			constexpr Iterator begin() const { return Iterator(_chunks.begin(), _chunks.end(), _func); }
+			constexpr auto end() const
+			{
+				if constexpr (CommonRange<Chunks>) return Iterator(_chunks.end(), _chunks.end(), _func);
+				else return std::default_sentinel;
+			}
+
+			constexpr std::size_t size() const requires Sized<TRange> { return _chunks.base().size(); }
+
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const
+			{
+				std::vector<U> out(_batch);
+				return _chunks.push([&](std::span<const typename Chunks::value_type> in)
+				{
+					std::span<U> results(out.data(), in.size());
+					_func(in, results);
+					for (U& result : results)
+					{
+						if (!sink(std::move(result))) return false;
+					}
+					return true;
+				});
+			}
+
+		private:
+			Chunks _chunks;
+			[[no_unique_address]] Func _func;
+			std::size_t _batch;
+		};
+
+		template <class U, typename TRange, class Func>
+		constexpr auto map_batch_impl(TRange&& range, Func func, std::size_t batch)
+		{
+			return TMapBatch<TRange, U, Func>(std::forward<TRange>(range), std::move(func), batch);
+		}
+
+		template <typename TRange, class Func>
+		constexpr void for_each_batch_impl(TRange&& range, Func&& func, std::size_t batch)
+		{
+			chunk_impl(range, batch).push([&](auto span) { func(span); return true; });
+		}
+
+		// Pairs up the elements of two ranges in lock step and stops at the end of the
+		// shorter one. Yields std::pair<L, R> of copies, so results outlive both sources.
+		template <class TLeft, class TRight>
+		class TZip
+		{
+		public:
+			using ItLeft = iterator_t<TLeft>;
+			using ItRight = iterator_t<TRight>;
+			using value_type = std::pair<std::remove_cvref_t<decltype(*std::declval<ItLeft>())>, std::remove_cvref_t<decltype(*std::declval<ItRight>())>>;
+			static constexpr bool random_access = RandomAccessIterator<ItLeft> && RandomAccessIterator<ItRight>;
+			using Ends = Sentinel<std::pair<sentinel_t<TLeft>, sentinel_t<TRight>>>;
+
+			class Iterator
+			{
+			public:
+				using value_type = TZip::value_type;
+				using reference = value_type;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::conditional_t<random_access, std::random_access_iterator_tag, std::forward_iterator_tag>;
+
+				constexpr Iterator(ItLeft left, ItRight right) : _left(left), _right(right) {}
+
+				constexpr reference operator*() const { return value_type(*_left, *_right); }
+				constexpr Iterator& operator++() { ++_left; ++_right; return *this; }
+				constexpr Iterator& operator--() requires random_access { --_left; --_right; return *this; }
+				// end() of a random-access zip is cut to the shorter side, otherwise either side reaching its end ends the zip
+				constexpr bool operator==(const Iterator& other) const { return !(*this != other); }
+				constexpr bool operator!=(const Iterator& other) const
+				{
+					if constexpr (random_access) return _left != other._left;
+					else return _left != other._left && _right != other._right;
+				}
+				constexpr bool operator==(const Ends& ends) const { return !(_left != ends.end.first) || !(_right != ends.end.second); }
+
+				constexpr Iterator& operator+=(difference_type n) requires random_access { _left += n; _right += n; return *this; }
+				constexpr Iterator& operator-=(difference_type n) requires random_access { _left -= n; _right -= n; return *this; }
+				constexpr Iterator operator+(difference_type n) const requires random_access { return Iterator(_left + n, _right + n); }
+				constexpr Iterator operator-(difference_type n) const requires random_access { return Iterator(_left - n, _right - n); }
+				constexpr difference_type operator-(const Iterator& other) const requires random_access { return _left - other._left; }
+				constexpr reference operator[](difference_type n) const requires random_access { return value_type(_left[n], _right[n]); }
+				constexpr bool operator<(const Iterator& other) const requires random_access { return _left < other._left; }
+
+			private:
+				ItLeft _left;
+				ItRight _right;
+			};
+
+			constexpr TZip(TLeft left, TRight right)
+				: _left(std::forward<TLeft>(left)), _right(std::forward<TRight>(right)) {
+			}
+
+			constexpr Iterator begin() const { return Iterator(_left.begin(), _right.begin()); }
+			constexpr auto end() const
+			{
+				if constexpr (random_access)
+				{
+					auto n = std::min<std::ptrdiff_t>(_left.end() - _left.begin(), _right.end() - _right.begin());
+					return Iterator(_left.begin() + n, _right.begin() + n);
+				}
+				else if constexpr (CommonRange<TLeft> && CommonRange<TRight>) return Iterator(_left.end(), _right.end());
+				else return Ends{ { _left.end(), _right.end() } };
+			}
+
+			constexpr std::size_t size() const requires Sized<TLeft> && Sized<TRight> { return std::min<std::size_t>(_left.size(), _right.size()); }
+
+			// The left side pushes, the right side is pulled along
+			template <class Sink>
+			constexpr bool push(Sink&& sink) const requires Pushable<TLeft>
+			{
+				auto right = _right.begin();
+				auto right_end = _right.end();
+				bool stopped = false;
+				_left.push([&](auto&& item)
+				{
+					if (!(right != right_end)) return false;
+					if (!sink(value_type(std::forward<decltype(item)>(item), *right)))
+					{
+						stopped = true;
+						return false;
+					}
+					++right;
+					return true;
+				});
+				return !stopped;
+			}
+
+			constexpr std::size_t split_size() const requires Splittable<TLeft> && Splittable<TRight>
+			{
+				return std::min<std::size_t>(_left.split_size(), _right.split_size());
+			}
+			constexpr auto slice(std::size_t from, std::size_t to) const requires Splittable<TLeft> && Splittable<TRight>
+			{
+				return TZip<decltype(_left.slice(from, to)), decltype(_right.slice(from, to))>(_left.slice(from, to), _right.slice(from, to));
+			}
+
+		private:
+			TLeft _left;
+			TRight _right;
+		};
+
+		template <typename TLeft, typename TRight>
+		constexpr auto zip_impl(TLeft&& left, TRight&& right)
+		{
+			return TZip<TLeft, TRight>(std::forward<TLeft>(left), std::forward<TRight>(right));
+		}
+
+		// Presize for hash tables whose number of distinct keys is unknown
+		constexpr std::size_t default_hash_reserve = 1024;
+
+		// Build side of a hash join: the rows in their original order, a head row per
+		// distinct key and a link from every row to the next one with the same key
+		template <class T, class Key>
+		class JoinTable
+		{
+		public:
+			static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+			template <class TRange, class KeyFunc>
+			JoinTable(const TRange& range, const KeyFunc& key)
+			{
+				if constexpr (Sized<TRange>)
+				{
+					_rows.reserve(range.size());
+					_heads.reserve(std::min(range.size(), default_hash_reserve));
+				}
+				drive(range, [&](auto&& item) { _rows.push_back(std::forward<decltype(item)>(item)); return true; });
+				if (_rows.size() >= npos) throw std::length_error("hash_join: build side is too large");
+
+				// Linked back to front, so that matches come out in the order of the rows
+				_next.resize(_rows.size(), npos);
+				for (std::uint32_t i = static_cast<std::uint32_t>(_rows.size()); i-- > 0;)
+				{
+					auto [head, inserted] = _heads.try_emplace(Key(std::invoke(key, std::as_const(_rows[i]))), i);
+					if (!inserted) _next[i] = std::exchange(head->second, i);
+				}
+			}
+
+			std::uint32_t find(const Key& key) const
+			{
+				auto it = _heads.find(key);
+				return it == _heads.end() ? npos : it->second;
+			}
+			std::uint32_t next(std::uint32_t row) const { return _next[row]; }
+			const T& row(std::uint32_t row) const { return _rows[row]; }
+
+		private:
+			std::vector<T> _rows;
+			std::vector<std::uint32_t> _next;
+			FlatHashMap<Key, std::uint32_t> _heads;
+		};
+
+		// Inner equi-join. The hash table is built once from the smaller side when both
+		// sizes are known, from the right side otherwise, and the other side streams
+		// through it. Yields std::pair<L, R> of copies for every matching pair.
+		template <class TLeft, class TRight, class KeyLeft, class KeyRight>
+		class THashJoin
+		{
+		public:
+			using Left = std::remove_cvref_t<decltype(*std::declval<iterator_t<TLeft>>())>;
+			using Right = std::remove_cvref_t<decltype(*std::declval<iterator_t<TRight>>())>;
+			// Keys of both sides are converted to this, e.g. int and long long to long long
+			using Key = std::common_type_t<std::remove_cvref_t<std::invoke_result_t<const KeyLeft&, const Left&>>,
+				std::remove_cvref_t<std::invoke_result_t<const KeyRight&, const Right&>>>;
+			using value_type = std::pair<Left, Right>;
+
+		private:
+			// Walks the probe side and the chain of matches of its current element
+			template <bool ProbeLeft>
+			class Cursor
+			{
+			public:
+				using ProbeRange = std::conditional_t<ProbeLeft, TLeft, TRight>;
+				using It = iterator_t<ProbeRange>;
+				using End = sentinel_t<ProbeRange>;
+				using Probe = std::conditional_t<ProbeLeft, Left, Right>;
+				using Build = std::conditional_t<ProbeLeft, Right, Left>;
+
+				Cursor(const THashJoin& join, It it, End end) : _join(&join), _it(it), _end(end) { advance(); }
+
+				value_type operator*() const
+				{
+					if constexpr (ProbeLeft) return value_type(item(), table().row(_match));
+					else return value_type(table().row(_match), item());
+				}
+				void next()
+				{
+					_match = table().next(_match);
+					if (_match != npos) return;
+					++_it;
+					advance();
+				}
+				bool operator==(const Cursor& other) const { return !(_it != other._it) && _match == other._match; }
+				// There is a match to hand out until the probe side runs out
+				bool done() const { return _match == npos; }
+
+			private:
+				// Points at the source element when that is safe, otherwise keeps a copy
+				static constexpr bool copies = !std::is_lvalue_reference_v<decltype(*std::declval<It>())> || StashingIterator<It>;
+
+				const THashJoin* _join;
+				It _it;
+				End _end;
+				std::conditional_t<copies, std::optional<Probe>, const Probe*> _item{};
+				std::uint32_t _match = npos;
+
+				const auto& table() const
+				{
+					if constexpr (ProbeLeft) return *_join->_right_table;
+					else return *_join->_left_table;
+				}
+				const Probe& item() const { return *_item; }
+
+				void advance()
+				{
+					for (; _it != _end; ++_it)
+					{
+						if constexpr (copies) _item.emplace(*_it);
+						else _item = &*_it;
+						_match = table().find(_join->probe_key<ProbeLeft>(item()));
+						if (_match != npos) return;
+					}
+					_match = npos;
+				}
+			};
+
+		public:
+			class Iterator
+			{
+			public:
+				using value_type = THashJoin::value_type;
+				using reference = value_type;
+				using difference_type = std::ptrdiff_t;
+				using iterator_category = std::forward_iterator_tag;
+
+				template <bool ProbeLeft>
+				explicit Iterator(Cursor<ProbeLeft> cursor) : _cursor(std::move(cursor)) {}
+
+				reference operator*() const { return std::visit([](const auto& cursor) { return *cursor; }, _cursor); }
+				Iterator& operator++() { std::visit([](auto& cursor) { cursor.next(); }, _cursor); return *this; }
+				bool operator==(const Iterator& other) const { return _cursor == other._cursor; }
+				bool operator!=(const Iterator& other) const { return !(_cursor == other._cursor); }
+				bool operator==(std::default_sentinel_t) const { return std::visit([](const auto& cursor) { return cursor.done(); }, _cursor); }
+
+			private:
+				std::variant<Cursor<true>, Cursor<false>> _cursor;
+			};
+
+			THashJoin(TLeft left, TRight right, KeyLeft key_left, KeyRight key_right)
+				: _left(std::forward<TLeft>(left)), _right(std::forward<TRight>(right)), _key_left(key_left), _key_right(key_right)
+			{
+				bool build_left = false;
+				if constexpr (Sized<TLeft> && Sized<TRight>)
+					build_left = _left.size() < _right.size();
+
+				if (build_left)
+					_left_table = std::make_shared<const JoinTable<Left, Key>>(_left, _key_left);
+				else
+					_right_table = std::make_shared<const JoinTable<Right, Key>>(_right, _key_right);
+			}
+
+			Iterator begin() const
+			{
+				if (_left_table) return Iterator(Cursor<false>(*this, _right.begin(), _right.end()));
+				return Iterator(Cursor<true>(*this, _left.begin(), _left.end()));
+			}
+			auto end() const
+			{
+				if constexpr (CommonRange<TLeft> && CommonRange<TRight>)
+				{
+					if (_left_table) return Iterator(Cursor<false>(*this, _right.end(), _right.end()));
+					return Iterator(Cursor<true>(*this, _left.end(), _left.end()));
+				}
+				else return std::default_sentinel;
+			}
+
+			template <class Sink>
+			bool push(Sink&& sink) const requires Pushable<TLeft> && Pushable<TRight>
+			{
+				if (_left_table) return probe_push<false>(_right, *_left_table, sink);
+				return probe_push<true>(_left, *_right_table, sink);
+			}
+
+			std::size_t split_size() const requires Splittable<TLeft> && Splittable<TRight>
+			{
+				return _left_table ? _right.split_size() : _left.split_size();
+			}
+			// Slices the probe side, the table is shared
+			auto slice(std::size_t from, std::size_t to) const requires Splittable<TLeft> && Splittable<TRight>
+			{
+				using Slice = THashJoin<decltype(_left.slice(from, to)), decltype(_right.slice(from, to)), KeyLeft, KeyRight>;
+				if (_left_table)
+					return Slice(_left.slice(0, _left.split_size()), _right.slice(from, to), _key_left, _key_right, _left_table, _right_table);
+				return Slice(_left.slice(from, to), _right.slice(0, _right.split_size()), _key_left, _key_right, _left_table, _right_table);
+			}
+
+		private:
+			static constexpr std::uint32_t npos = JoinTable<Left, Key>::npos;
+
+			TLeft _left;
+			TRight _right;
+			KeyLeft _key_left;
+			KeyRight _key_right;
+			// Exactly one of them is set
+			std::shared_ptr<const JoinTable<Left, Key>> _left_table;
+			std::shared_ptr<const JoinTable<Right, Key>> _right_table;
+
+			THashJoin(TLeft left, TRight right, KeyLeft key_left, KeyRight key_right,
+				std::shared_ptr<const JoinTable<Left, Key>> left_table, std::shared_ptr<const JoinTable<Right, Key>> right_table)
+				: _left(std::forward<TLeft>(left)), _right(std::forward<TRight>(right)), _key_left(key_left), _key_right(key_right),
+				_left_table(std::move(left_table)), _right_table(std::move(right_table)) {
+			}
+
+			template <bool ProbeLeft>
+			Key probe_key(const auto& item) const
+			{
+				if constexpr (ProbeLeft) return Key(std::invoke(_key_left, item));
+				else return Key(std::invoke(_key_right, item));
+			}
+
+			template <bool ProbeLeft, class TProbe, class Table, class Sink>
+			bool probe_push(const TProbe& probe, const Table& table, Sink& sink) const
+			{
+				return probe.push([&](auto&& item)
+				{
+					for (auto row = table.find(probe_key<ProbeLeft>(item)); row != npos; row = table.next(row))
+					{
+						bool more;
+						if constexpr (ProbeLeft) more = sink(value_type(item, table.row(row)));
+						else more = sink(value_type(table.row(row), item));
+						if (!more) return false;
+					}
+					return true;
+				});
+			}
+
+			template <class, class, class, class>
+			friend class THashJoin;
+		};
+
+		template <typename TLeft, typename TRight, class KeyLeft, class KeyRight>
+		auto hash_join_impl(TLeft&& left, TRight&& right, KeyLeft key_left, KeyRight key_right)
+		{
+			return THashJoin<TLeft, TRight, KeyLeft, KeyRight>(std::forward<TLeft>(left), std::forward<TRight>(right), key_left, key_right);
+		}
+
+		template <typename TRange, AllocatorLike Allocator>
+		constexpr auto to_vector_impl(TRange&& range, const Allocator& allocator)
+		{
+			using T = std::decay_t<decltype(*range.begin())>;
+			using ElementAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+			std::vector<T, ElementAllocator> result{ ElementAllocator(allocator) };
+			if constexpr (Sized<TRange>)
+				result.reserve(range.size());
+			drive(range, [&](auto&& item) { result.push_back(std::forward<decltype(item)>(item)); return true; });
+			return result;
+		}
+
+		template <typename TRange>
+		constexpr auto to_vector_impl(TRange&& range)
+		{
+			return to_vector_impl(range, std::allocator<std::decay_t<decltype(*range.begin())>>());
+		}
+
+		template <std::size_t N, bool TruncateOverflow, typename TRange>
+		constexpr auto to_static_vector_impl(TRange&& range)
+		{
+			if constexpr (Sized<TRange> && !TruncateOverflow)
+			{
+				if (range.size() > N) throw std::length_error("to_static_vector: range does not fit");
+			}
+
+			StaticVector<std::decay_t<decltype(*range.begin())>, N> result;
+			drive(range, [&](auto&& item)
+			{
+				if (result.size() == N)
+				{
+					if constexpr (TruncateOverflow) return false;
+					else throw std::length_error("to_static_vector: range does not fit");
+				}
+				result.emplace_back(std::forward<decltype(item)>(item));
+				return true;
+			});
+			return result;
+		}
+
+		template <std::size_t N, typename TRange>
+		auto to_small_vector_impl(TRange&& range)
+		{
+			SmallVector<std::decay_t<decltype(*range.begin())>, N> result;
+			if constexpr (Sized<TRange>)
+				result.reserve(range.size());
+			drive(range, [&](auto&& item) { result.emplace_back(std::forward<decltype(item)>(item)); return true; });
+			return result;
+		}
+
+		// Returns the part of out that was written
+		template <bool TruncateOverflow, typename TRange, typename T, std::size_t Extent>
+		constexpr std::span<T> into_impl(TRange&& range, std::span<T, Extent> out)
+		{
+			if constexpr (Sized<TRange> && !TruncateOverflow)
+			{
+				if (range.size() > out.size()) throw std::length_error("into: range does not fit");
+			}
+
+			std::size_t written = 0;
+			drive(range, [&](auto&& item)
+			{
+				if (written == out.size())
+				{
+					if constexpr (TruncateOverflow) return false;
+					else throw std::length_error("into: range does not fit");
+				}
+				out[written++] = std::forward<decltype(item)>(item);
+				return true;
+			});
+			return std::span<T>(out.data(), written);
+		}
+
+		// Returns the output iterator past the last written element
+		template <typename TRange, std::input_or_output_iterator TOutput>
+		constexpr TOutput into_impl(TRange&& range, TOutput out)
+		{
+			drive(range, [&](auto&& item)
+			{
+				*out = std::forward<decltype(item)>(item);
+				++out;
+				return true;
+			});
+			return out;
+		}
+
+		// Converts to the result of make() when the map constructs a value from it, so that
+		// try_emplace only computes the value for a new key
+		template <class Make>
+		struct LazyValue
+		{
+			Make make;
+			constexpr operator std::invoke_result_t<Make&>() { return make(); }
+		};
+
+		template <typename TRange, class KeyFunc, class Agg>
+		auto group_by_impl(TRange&& range, const KeyFunc& key_func, const Agg& agg, std::size_t expected_groups)
+		{
+			using Item = decltype(*range.begin());
+			using Key = std::remove_cvref_t<std::invoke_result_t<const KeyFunc&, Item>>;
+			using Acc = std::remove_cvref_t<decltype(agg.first(std::declval<Item>()))>;
+
+			FlatHashMap<Key, Acc> groups;
+			if (expected_groups != 0)
+				groups.reserve(expected_groups);
+			else if constexpr (Sized<TRange>)
+				groups.reserve(std::min(range.size(), default_hash_reserve));
+
+			drive(range, [&](auto&& item)
+			{
+				decltype(auto) key = std::invoke(key_func, item);
+				auto [it, inserted] = groups.try_emplace(key, LazyValue{ [&] { return agg.first(item); } });
+				if (!inserted)
+					agg.update(it->second, item);
+				return true;
+			});
+			return groups;
+		}
+
+		template <typename TRange>
+		constexpr void print_impl(TRange&& range)
+		{
+			drive(range, [](auto&& item) { std::cout << item << " "; return true; });
+		}
+
+		// Ranges whose elements can be assigned through their iterators, e.g. Range::from_mut
+		template <class T>
+		concept MutableRange = std::is_lvalue_reference_v<decltype(*std::declval<iterator_t<T>>())>
+			&& !std::is_const_v<std::remove_reference_t<decltype(*std::declval<iterator_t<T>>())>>;
+
+		template <class T>
+		concept ContiguousMutableRange = MutableRange<T> && CommonRange<T> && std::contiguous_iterator<iterator_t<T>>;
+
+		// Mutable ranges are walked through their iterators, since push() may hand out
+		// read-only views (e.g. SIMD filters) and writes have to reach the source.
+		// Contiguous ones become an indexed loop the compiler can vectorize.
+		template <typename TRange, class Func>
+		constexpr void for_each_impl(TRange&& range, const Func& func)
+		{
+			if constexpr (ContiguousMutableRange<TRange>)
+			{
+				auto* data = std::to_address(range.begin());
+				auto size = static_cast<std::size_t>(range.end() - range.begin());
+				for (std::size_t i = 0; i < size; ++i) func(data[i]);
+			}
+			else if constexpr (MutableRange<TRange>)
+			{
+				auto end = range.end();
+				for (auto it = range.begin(); it != end; ++it) func(*it);
+			}
+			else
+				drive(range, [&](auto&& item) { func(item); return true; });
+		}
+
+		template <typename TRange, class Func>
+		constexpr void transform_inplace_impl(TRange&& range, const Func& func)
+		{
+			static_assert(MutableRange<TRange>, "transform_inplace writes through the iterators, start the pipeline with Range::from_mut");
+			for_each_impl(range, [&](auto& item) { item = func(item); });
+		}
+
+		template <typename TRange>
+		constexpr auto sum_impl(TRange&& range)
+		{
+			if constexpr (Enumerated<TRange>)
+			{
+				auto values = values_of(range);
+				return arithmetic_series_sum(*values.begin(), values.size());
+			}
+			// Integer addition is associative, so it is always safe to vectorize
+			else if constexpr (IntegralBlockSource<TRange>)
+			{
+				if (!std::is_constant_evaluated()) return block_sum(range);
+			}
+
+			auto sum = static_cast<std::remove_cvref_t<decltype(*range.begin())>>(0);
+			drive(range, [&](auto&& item) { sum += item; return true; });
+			return sum;
+		}
+
+		// Writes the running totals of the range, starting from carry, to out, which has
+		// room for all of them, and returns the last one
+		template <typename TRange, typename T>
+		T prefix_sums_into(const TRange& range, T* out, T carry)
+		{
+			if constexpr (BlockSource<TRange>)
+			{
+				for_each_block(range, [&](const T* data, std::size_t size)
+				{
+					carry = simd::prefix_sum(data, out, size, carry);
+					out += size;
+				});
+			}
+			else
+			{
+				drive(range, [&](auto&& item)
+				{
+					carry += item;
+					*out++ = carry;
+					return true;
+				});
+			}
+			return carry;
+		}
+
+		// Exclusive sums are the inclusive ones moved one place to the right behind a 0
+		template <bool Exclusive, typename TRange>
+		auto to_prefix_sums_impl(TRange&& range)
+		{
+			using T = std::remove_cvref_t<decltype(*range.begin())>;
+			std::vector<T> sums;
+			if constexpr (Sized<TRange>)
+			{
+				sums.resize(range.size() + (Exclusive ? 1 : 0));
+				prefix_sums_into(range, sums.data() + (Exclusive ? 1 : 0), T(0));
+			}
+			else
+			{
+				if constexpr (Exclusive) sums.push_back(T(0));
+				T total(0);
+				drive(range, [&](auto&& item)
+				{
+					total += item;
+					sums.push_back(total);
+					return true;
+				});
+			}
+			if constexpr (Exclusive) sums.pop_back();
+			return sums;
+		}
+
+		template <typename TRange>
+		constexpr auto sum_impl(TRange&& range, Reassociate)
+		{
+			if constexpr (BlockSource<TRange>)
+			{
+				if (!std::is_constant_evaluated()) return block_sum(range);
+			}
+			return sum_impl(range);
+		}
 
-				constexpr auto operator*() const { return *_it; }
-				constexpr Iterator& operator++()
-				{
-					++_it;
-					advance();
-					return *this;
-				}
-				constexpr Iterator& operator--()
+		template <bool Max, typename TRange>
+		constexpr auto extreme_impl(TRange&& range)
+		{
+			using T = std::remove_cvref_t<decltype(*range.begin())>;
+			if constexpr (Enumerated<TRange>)
+			{
+				auto values = values_of(range);
+				if (values.size() == 0) throw std::out_of_range(Max ? "max of an empty range" : "min of an empty range");
+				return Max ? *(values.end() - 1) : *values.begin();
+			}
+			else if constexpr (BlockSource<TRange>)
+			{
+				if (!std::is_constant_evaluated())
 				{
-					reverse();
-					return *this;
+					bool empty = true;
+					T best{};
+					for_each_block(range, [&](const T* data, std::size_t size)
+					{
+						if (size == 0) return;
+						T value = Max ? simd::max(data, size) : simd::min(data, size);
+						if (empty || (Max ? best < value : value < best)) best = value;
+						empty = false;
+					});
+					if (empty) throw std::out_of_range(Max ? "max of an empty range" : "min of an empty range");
+					return best;
 				}
-				constexpr bool operator!=(const Iterator& other) const { return _it != other._it; }
+			}
 
-			private:
-				It _it;
-				It _end;
-				It _begin;
-				Func _func;
+			std::optional<T> best;
+			drive(range, [&](auto&& item)
+			{
+				if (!best || (Max ? *best < item : item < *best)) best.emplace(std::forward<decltype(item)>(item));
+				return true;
+			});
+			if (!best) throw std::out_of_range(Max ? "max of an empty range" : "min of an empty range");
+			return *best;
+		}
 
-				constexpr void advance()
-				{
-					while (_it != _end && !_func(*_it)) ++_it;
-				}
-				constexpr void reverse()
+		template <typename TRange>
+		constexpr auto min_impl(TRange&& range) { return extreme_impl<false>(range); }
+
+		template <typename TRange>
+		constexpr auto max_impl(TRange&& range) { return extreme_impl<true>(range); }
+
+		template <typename TRange>
+		constexpr auto minmax_impl(TRange&& range)
+		{
+			using T = std::remove_cvref_t<decltype(*range.begin())>;
+			if constexpr (Enumerated<TRange>)
+			{
+				auto values = values_of(range);
+				if (values.size() == 0) throw std::out_of_range("minmax of an empty range");
+				return std::pair<T, T>(*values.begin(), *(values.end() - 1));
+			}
+			else if constexpr (BlockSource<TRange>)
+			{
+				if (!std::is_constant_evaluated())
 				{
-					while (_it != _begin && !_func(*_it)) --_it;
+					bool empty = true;
+					std::pair<T, T> result{};
+					for_each_block(range, [&](const T* data, std::size_t size)
+					{
+						if (size == 0) return;
+						auto [lo, hi] = simd::minmax(data, size);
+						if (empty || lo < result.first) result.first = lo;
+						if (empty || result.second < hi) result.second = hi;
+						empty = false;
+					});
+					if (empty) throw std::out_of_range("minmax of an empty range");
+					return result;
 				}
-			};
-
-			constexpr TFilter(TRange range, Func func)
-				: _range(range), _func(func) {
 			}
 
-			constexpr Iterator begin() const { return Iterator(_range.begin(), _range.end(), _range.begin(), _func); }
-			constexpr Iterator end() const { return Iterator(_range.end(), _range.end(), _range.begin(), _func); }
+			std::optional<std::pair<T, T>> result;
+			drive(range, [&](auto&& item)
+			{
+				if (!result) result.emplace(item, item);
+				else if (item < result->first) result->first = item;
+				else if (result->second < item) result->second = item;
+				return true;
+			});
+			if (!result) throw std::out_of_range("minmax of an empty range");
+			return *result;
+		}
 
-		private:
-			TRange _range;
-			Func _func;
-		};
+		template <typename TRange>
+		constexpr std::size_t count_impl(TRange&& range)
+		{
+			if constexpr (Sized<TRange>)
+				return range.size();
+			else
+			{
+				std::size_t count = 0;
+				for (auto it = range.begin(); it != range.end(); ++it) ++count;
+				return count;
+			}
+		}
 
-		template <typename TRange, class Func>
-		constexpr auto filter_impl(TRange&& range, Func pred)
+		template <typename TRange, typename Func>
+		constexpr std::size_t count_impl(TRange&& range, Func&& pred)
 		{
-			return TFilter<TRange, Func>(std::forward<TRange>(range), pred);
+			if constexpr (EnumeratedCompare<TRange, Func>)
+				return enumerated_count(values_of(range), pred);
+
+			std::size_t count = 0;
+			drive(range, [&](auto&& item) { count += pred(item) ? 1 : 0; return true; });
+			return count;
 		}
 
-		template <class TRange, std::integral TNumber>
-		class TSkip
+		// Keeps the k best elements by cmp in a heap whose top is the worst of them,
+		// then sorts it best first
+		template <typename Heap, typename TRange, typename Compare>
+		constexpr void bounded_heap_impl(Heap& heap, std::size_t k, TRange&& range, const Compare& cmp)
 		{
-		public:
-			class Iterator
+			if (k == 0) return;
+			auto heap_cmp = [&](const auto& a, const auto& b) { return cmp(b, a); };
+			drive(range, [&](auto&& item)
 			{
-			public:
-				using It = decltype(std::declval<TRange>().begin());
-				constexpr Iterator(It it, It end, TNumber skip)
-					: _it(it)
+				if (heap.size() < k)
 				{
-					for (TNumber i = static_cast<TNumber>(0); _it != end && i < skip; i++)
-					{
-						++_it;
-					}
+					heap.push_back(std::forward<decltype(item)>(item));
+					std::push_heap(heap.begin(), heap.end(), heap_cmp);
+				}
+				else if (cmp(heap.front(), item))
+				{
+					std::pop_heap(heap.begin(), heap.end(), heap_cmp);
+					heap.back() = std::forward<decltype(item)>(item);
+					std::push_heap(heap.begin(), heap.end(), heap_cmp);
 				}
+				return true;
+			});
+			// Sorted through pointers: over StaticVector iterators GCC's -Warray-bounds
+			// cannot see that the heap fits its capacity
+			std::sort_heap(heap.data(), heap.data() + heap.size(), heap_cmp);
+		}
 
-				constexpr auto operator*() const { return *_it; }
-				constexpr Iterator& operator++() { ++_it; return *this; }
-				constexpr Iterator& operator--() { --_it; return *this; }
-				constexpr bool operator!=(const Iterator& other) const { return _it != other._it; }
+		// cmp is taken by value: comparators are usually empty, and GCC warns about
+		// reading an empty one through a reference at -O2
+		template <std::size_t N, typename TRange, typename Compare>
+		constexpr auto top_k_impl(TRange&& range, Compare cmp)
+		{
+			StaticVector<std::remove_cvref_t<decltype(*range.begin())>, N> heap;
+			bounded_heap_impl(heap, N, range, cmp);
+			return heap;
+		}
 
-			private:
-				It _it;
-			};
+		template <typename TRange, typename Compare>
+		constexpr auto top_k_impl(TRange&& range, std::size_t k, Compare cmp)
+		{
+			std::vector<std::remove_cvref_t<decltype(*range.begin())>> heap;
+			if constexpr (Sized<TRange>)
+				heap.reserve(std::min(k, range.size()));
+			bounded_heap_impl(heap, k, range, cmp);
+			return heap;
+		}
 
-			constexpr TSkip(TRange range, TNumber skip)
-				: _range(range), _skip(skip) {
-			}
+		template <class K>
+		concept RadixKey = std::integral<K> && !std::same_as<K, bool>;
 
-			constexpr Iterator begin() const { return Iterator(_range.begin(), _range.end(), _skip); }
-			constexpr Iterator end() const { return Iterator(_range.end(), _range.end(), 0); }
+		// Below this many elements std::sort wins over the histogram passes
+		constexpr std::size_t radix_sort_threshold = 256;
 
-		private:
-			TRange _range;
-			TNumber _skip;
-		};
+		// Maps keys to unsigned integers with the same order
+		template <RadixKey K>
+		constexpr auto radix_bits(K key)
+		{
+			using U = std::make_unsigned_t<K>;
+			U bits = static_cast<U>(key);
+			if constexpr (std::is_signed_v<K>) bits ^= U(1) << (sizeof(U) * 8 - 1);
+			return bits;
+		}
 
-		template <typename TRange, std::integral TNumber>
-		constexpr auto skip_impl(TRange&& range, TNumber skip)
+		// Stable LSD radix sort by key, one byte per pass. Passes in which every key
+		// has the same byte are skipped, so small key ranges cost few passes.
+		template <typename T, typename KeyFunc>
+		void radix_sort(std::vector<T>& items, const KeyFunc& key)
 		{
-			return TSkip<TRange, TNumber>(std::forward<TRange>(range), skip);
+			using K = std::remove_cvref_t<std::invoke_result_t<const KeyFunc&, const T&>>;
+			constexpr std::size_t passes = sizeof(K);
+			if (items.empty()) return;
+
+			std::array<std::array<std::size_t, 256>, passes> counts{};
+			for (const T& item : items)
+			{
+				auto bits = radix_bits(std::invoke(key, item));
+				for (std::size_t pass = 0; pass < passes; ++pass)
+					++counts[pass][(bits >> (pass * 8)) & 0xFF];
+			}
+
+			std::vector<T> buffer(items.size());
+			T* from = items.data();
+			T* to = buffer.data();
+			auto first_bits = radix_bits(std::invoke(key, items.front()));
+			for (std::size_t pass = 0; pass < passes; ++pass)
+			{
+				auto& count = counts[pass];
+				if (count[(first_bits >> (pass * 8)) & 0xFF] == items.size()) continue;
+
+				std::size_t offset = 0;
+				for (auto& c : count) offset += std::exchange(c, offset);
+				for (std::size_t i = 0; i < items.size(); ++i)
+					to[count[(radix_bits(std::invoke(key, from[i])) >> (pass * 8)) & 0xFF]++] = std::move(from[i]);
+				std::swap(from, to);
+			}
+			if (from != items.data()) items.swap(buffer);
 		}
 
-		template <class TRange, std::integral TNumber>
-		class TTake
+		template <typename TRange, typename KeyFunc>
+		auto sorted_by_key_impl(TRange&& range, const KeyFunc& key)
 		{
-		public:
-			class Iterator
+			auto items = to_vector_impl(range);
+			using T = typename decltype(items)::value_type;
+			using K = std::remove_cvref_t<std::invoke_result_t<const KeyFunc&, const T&>>;
+
+			auto less = [&](const T& a, const T& b) { return std::invoke(key, a) < std::invoke(key, b); };
+			if constexpr (RadixKey<K>)
 			{
-			public:
-				using It = decltype(std::declval<TRange>().begin());
-				constexpr Iterator(It it, It end, TNumber amount)
-					: _it(it)
+				if constexpr (std::is_default_constructible_v<T>)
 				{
-					for (TNumber i = static_cast<TNumber>(0); _it != end && i < amount; i++)
+					if (items.size() >= radix_sort_threshold)
 					{
-						++_it;
+						radix_sort(items, key);
+						return items;
 					}
 				}
+				// Stable like the radix sort, so integer keys keep their order at every size
+				std::stable_sort(items.begin(), items.end(), less);
+			}
+			else
+				std::sort(items.begin(), items.end(), less);
+			return items;
+		}
 
-				constexpr auto operator*() const { return *_it; }
-				constexpr Iterator& operator++() { ++_it; return *this; }
-				constexpr Iterator& operator--() { --_it; return *this; }
-				constexpr bool operator!=(const Iterator& other) const { return _it != other._it; }
+		template <typename TRange, typename Compare>
+		auto sorted_by_impl(TRange&& range, const Compare& cmp)
+		{
+			auto items = to_vector_impl(range);
+			std::sort(items.begin(), items.end(), cmp);
+			return items;
+		}
 
-			private:
-				It _it;
-			};
+		template <typename TRange, typename Func>
+		constexpr auto all_impl(TRange&& range, Func&& pred)
+		{
+			if constexpr (EnumeratedCompare<TRange, Func>)
+				return count_impl(range, pred) == values_of(range).size();
+			else if constexpr (Sized<TRange>)
+			{
+				if (range.size() == 0) return true;
+			}
+			return drive(range, [&](auto&& item) { return static_cast<bool>(pred(item)); });
+		}
 
-			constexpr TTake(TRange range, TNumber amount)
-				: _range(range), _amount(amount) {
+		template <typename TRange, typename Func>
+		constexpr auto any_impl(TRange&& range, Func&& pred)
+		{
+			if constexpr (EnumeratedCompare<TRange, Func>)
+				return count_impl(range, pred) != 0;
+			else if constexpr (Sized<TRange>)
+			{
+				if (range.size() == 0) return false;
 			}
+			return !drive(range, [&](auto&& item) { return !pred(item); });
+		}
 
-			constexpr Iterator begin() const { return Iterator(_range.begin(), _range.end(), 0); }
-			constexpr Iterator end() const { return Iterator(_range.begin(), _range.end(), _amount); }
+		template <typename TRange, typename Func>
+		constexpr auto none_impl(TRange&& range, Func&& pred)
+		{
+			if constexpr (EnumeratedCompare<TRange, Func>)
+				return count_impl(range, pred) == 0;
+			else if constexpr (Sized<TRange>)
+			{
+				if (range.size() == 0) return true;
+			}
+			return drive(range, [&](auto&& item) { return !pred(item); });
+		}
 
-		private:
-			TRange _range;
-			TNumber _amount;
-		};
+		constexpr std::size_t parallel_min_chunk = 4096;
 
-		template <typename TRange, std::integral TNumber>
-		constexpr auto take_impl(TRange&& range, TNumber amount)
+		template <typename TRange>
+		std::size_t parallel_chunk_count(const TRange& range, ParallelPolicy policy)
 		{
-			return TTake<TRange, TNumber>(std::forward<TRange>(range), amount);
+			std::size_t workers = policy.threads != 0 ? policy.threads : ThreadPool::global().size() + 1;
+			std::size_t by_size = range.split_size() / parallel_min_chunk;
+			return std::clamp<std::size_t>(by_size, 1, workers * 4);
 		}
 
-		template <class TRange>
-		class TReverse
+		template <typename TRange, typename Func>
+		void parallel_for_chunks(const TRange& range, std::size_t chunks, ParallelPolicy policy, Func&& fn)
 		{
-		public:
-			class Iterator
+			std::size_t size = range.split_size();
+			ThreadPool::global().parallel_for(chunks, [&](std::size_t i)
 			{
-			public:
-				using It = decltype(std::declval<TRange>().begin());
-				constexpr Iterator(It it) : _it(it) {}
-
-				constexpr auto operator*() const { return *_it; }
-				constexpr Iterator& operator++() { --_it; return *this; }
-				constexpr Iterator& operator--() { ++_it; return *this; }
-				constexpr bool operator!=(const Iterator& other) const { return _it != other._it; }
-
-			private:
-				It _it;
-			};
+				fn(i, range.slice(size * i / chunks, size * (i + 1) / chunks));
+			}, policy.threads);
+		}
 
-			constexpr TReverse(TRange range) : _range(range) {}
+		template <typename TRange>
+		auto to_vector_impl(TRange&& range, ParallelPolicy policy)
+		{
+			if constexpr (!Splittable<TRange>)
+				return to_vector_impl(range);
+			else
+			{
+				std::size_t chunks = parallel_chunk_count(range, policy);
+				if (chunks < 2) return to_vector_impl(range);
 
-			constexpr Iterator begin() const { return Iterator(--_range.end()); }
-			constexpr Iterator end() const { return Iterator(--_range.begin()); }
+				std::vector<decltype(to_vector_impl(range))> parts(chunks);
+				parallel_for_chunks(range, chunks, policy, [&](std::size_t i, auto&& chunk)
+				{
+					parts[i] = to_vector_impl(chunk);
+				});
 
-		private:
-			TRange _range;
-		};
+				std::size_t total = 0;
+				for (auto& part : parts) total += part.size();
 
-		template <typename TRange>
-		constexpr auto reverse_impl(TRange&& range)
-		{
-			return TReverse<TRange>(std::forward<TRange>(range));
+				decltype(to_vector_impl(range)) result;
+				result.reserve(total);
+				for (auto& part : parts)
+					result.insert(result.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+				return result;
+			}
 		}
 
-		template <class T>
-		class TEnumerate
+		template <typename TRange>
+		auto sum_impl(TRange&& range, ParallelPolicy policy)
 		{
-		public:
-			class Iterator
+			if constexpr (!Splittable<TRange> || Enumerated<TRange>)
+				return sum_impl(range);
+			else
 			{
-			public:
-				constexpr Iterator(T it) : _it(it) {}
-
-				constexpr auto operator*() const { return _it; }
-				constexpr Iterator& operator++() { ++_it; return *this; }
-				constexpr Iterator& operator--() { --_it; return *this; }
-				constexpr bool operator!=(const Iterator& other) const { return _it != other._it; }
+				std::size_t chunks = parallel_chunk_count(range, policy);
+				if (chunks < 2) return sum_impl(range);
 
-			private:
-				T _it;
-			};
+				std::vector<decltype(sum_impl(range))> partial(chunks);
+				parallel_for_chunks(range, chunks, policy, [&](std::size_t i, auto&& chunk)
+				{
+					partial[i] = sum_impl(chunk);
+				});
 
-			constexpr TEnumerate(T min_, T max_)
-				: _min(min_), _max(max_) {
+				auto sum = static_cast<decltype(sum_impl(range))>(0);
+				for (auto& value : partial)
+					sum += value;
+				return sum;
 			}
+		}
 
-			constexpr Iterator begin() const { return Iterator(_min); }
-			constexpr Iterator end() const { return Iterator(_max); }
-
-		private:
-			T _min;
-			T _max;
-		};
+		// func is called from several threads at once, each on its own elements
+		template <typename TRange, class Func>
+		void for_each_impl(TRange&& range, ParallelPolicy policy, const Func& func)
+		{
+			if constexpr (!Splittable<TRange>)
+				for_each_impl(range, func);
+			else
+			{
+				std::size_t chunks = parallel_chunk_count(range, policy);
+				if (chunks < 2) return for_each_impl(range, func);
 
+				parallel_for_chunks(range, chunks, policy, [&](std::size_t, auto&& chunk)
+				{
+					for_each_impl(chunk, func);
+				});
+			}
+		}
 
-		template <typename TRange>
-		constexpr auto to_vector_impl(TRange&& range)
+		template <typename TRange, class Func>
+		void transform_inplace_impl(TRange&& range, ParallelPolicy policy, const Func& func)
 		{
-			std::vector<std::decay_t<decltype(*range.begin())>> result;
-			for (auto&& item : range)
-				result.push_back(item);
-			return result;
+			static_assert(MutableRange<TRange>, "transform_inplace writes through the iterators, start the pipeline with Range::from_mut");
+			for_each_impl(range, policy, [&](auto& item) { item = func(item); });
 		}
 
-		template <typename TRange>
-		constexpr void print_impl(TRange&& range)
+		// Two passes: every chunk is summed, the totals of the chunks before each one
+		// become its starting offset, and then every chunk writes its running totals.
+		// Floating point sums are regrouped at chunk boundaries.
+		template <bool Exclusive, typename TRange>
+		auto to_prefix_sums_impl(TRange&& range, ParallelPolicy policy)
 		{
-			for (auto&& item : range)
+			if constexpr (!Splittable<TRange> || !Sized<TRange>)
+				return to_prefix_sums_impl<Exclusive>(range);
+			else
 			{
-				std::cout << item << " ";
+				std::size_t chunks = parallel_chunk_count(range, policy);
+				if (chunks < 2) return to_prefix_sums_impl<Exclusive>(range);
+
+				using T = std::remove_cvref_t<decltype(*range.begin())>;
+				std::vector<T> offsets(chunks);
+				parallel_for_chunks(range, chunks, policy, [&](std::size_t i, auto&& chunk)
+				{
+					offsets[i] = sum_impl(chunk);
+				});
+				T total(0);
+				for (T& offset : offsets)
+				{
+					T chunk_total = offset;
+					offset = total;
+					total += chunk_total;
+				}
+
+				std::vector<T> sums(range.size() + (Exclusive ? 1 : 0));
+				T* out = sums.data() + (Exclusive ? 1 : 0);
+				std::size_t size = range.split_size();
+				parallel_for_chunks(range, chunks, policy, [&](std::size_t i, auto&& chunk)
+				{
+					prefix_sums_into(chunk, out + size * i / chunks, offsets[i]);
+				});
+				if constexpr (Exclusive) sums.pop_back();
+				return sums;
 			}
 		}
 
-		template <typename TRange>
-		constexpr auto sum_impl(TRange&& range)
+		// Every worker aggregates its chunk into a map of its own, the maps are merged at the end
+		template <typename TRange, class KeyFunc, class Agg>
+		auto group_by_impl(TRange&& range, ParallelPolicy policy, const KeyFunc& key_func, const Agg& agg, std::size_t expected_groups)
 		{
-			auto sum = static_cast<std::remove_all_extents_t<decltype(*range.begin())>>(0);
-			for (auto&& item : range)
+			if constexpr (!Splittable<TRange>)
+				return group_by_impl(range, key_func, agg, expected_groups);
+			else
 			{
-				sum += item;
+				std::size_t chunks = parallel_chunk_count(range, policy);
+				if (chunks < 2) return group_by_impl(range, key_func, agg, expected_groups);
+
+				std::vector<decltype(group_by_impl(range, key_func, agg, expected_groups))> parts(chunks);
+				parallel_for_chunks(range, chunks, policy, [&](std::size_t i, auto&& chunk)
+				{
+					parts[i] = group_by_impl(chunk, key_func, agg, expected_groups);
+				});
+
+				auto largest = std::max_element(parts.begin(), parts.end(), [](const auto& a, const auto& b) { return a.size() < b.size(); });
+				auto result = std::move(*largest);
+				for (auto& part : parts)
+				{
+					for (auto& [key, acc] : part)
+					{
+						auto [it, inserted] = result.try_emplace(key, std::move(acc));
+						if (!inserted) agg.merge(it->second, std::move(acc));
+					}
+				}
+				return result;
 			}
-			return sum;
 		}
 
+		// Returns whether some element has pred(item) == target. Workers stop as soon
+		// as any of them has found one.
 		template <typename TRange, typename Func>
-		constexpr auto all_impl(TRange&& range, Func&& pred)
+		bool parallel_find_impl(TRange&& range, ParallelPolicy policy, Func&& pred, bool target)
 		{
-			for (auto&& item : range)
+			std::size_t chunks = parallel_chunk_count(range, policy);
+			std::atomic<bool> found = false;
+			parallel_for_chunks(range, chunks, policy, [&](std::size_t, auto&& chunk)
 			{
-				if (!pred(item)) return false;
-			}
-			return true;
+				drive(chunk, [&](auto&& item)
+				{
+					if (found.load(std::memory_order_relaxed)) return false;
+					if (static_cast<bool>(pred(item)) != target) return true;
+					found.store(true, std::memory_order_relaxed);
+					return false;
+				});
+			});
+			return found.load();
 		}
 
 		template <typename TRange, typename Func>
-		constexpr auto any_impl(TRange&& range, Func&& pred)
+		bool all_impl(TRange&& range, ParallelPolicy policy, Func&& pred)
 		{
-			for (auto&& item : range)
-			{
-				if (pred(item)) return true;
-			}
-			return false;
+			if constexpr (!Splittable<TRange> || EnumeratedCompare<TRange, Func>)
+				return all_impl(range, pred);
+			else
+				return !parallel_find_impl(range, policy, pred, false);
 		}
 
 		template <typename TRange, typename Func>
-		constexpr auto none_impl(TRange&& range, Func&& pred)
+		bool any_impl(TRange&& range, ParallelPolicy policy, Func&& pred)
 		{
-			for (auto&& item : range)
-			{
-				if (pred(item)) return false;
-			}
-			return true;
+			if constexpr (!Splittable<TRange> || EnumeratedCompare<TRange, Func>)
+				return any_impl(range, pred);
+			else
+				return parallel_find_impl(range, policy, pred, true);
+		}
+
+		template <typename TRange, typename Func>
+		bool none_impl(TRange&& range, ParallelPolicy policy, Func&& pred)
+		{
+			if constexpr (!Splittable<TRange> || EnumeratedCompare<TRange, Func>)
+				return none_impl(range, pred);
+			else
+				return !parallel_find_impl(range, policy, pred, true);
 		}
 	}
 
@@ -368,6 +3365,47 @@ namespace uutils::data_processing
 		{
 			return detail::TRange{ std::begin(iterable), std::end(iterable) };
 		}
+		// A temporary container would be destroyed under the range. Views such as
+		// std::string_view and std::span do not own their elements and are accepted.
+		template <class Container>
+			requires detail::Iterable<Container> && (!std::is_lvalue_reference_v<Container>) && (!std::ranges::borrowed_range<Container>)
+		static auto from(Container&&) = delete; // use Range::own(std::move(container)) for rvalue containers
+
+		// Like from, but hands out mutable references, so for_each and transform_inplace
+		// can write back into the container
+		template <detail::Iterable Container>
+			requires (!std::is_const_v<Container>)
+		constexpr static auto from_mut(Container& container)
+		{
+			return detail::TRange{ std::begin(container), std::end(container) };
+		}
+
+		// Takes over a container passed as an rvalue, e.g. Range::own(std::move(rows)). It
+		// lives as long as the range or any pipeline built on it, and may be move-only.
+		template <class Container>
+			requires detail::Iterable<Container> && (!std::is_lvalue_reference_v<Container>)
+		static auto own(Container&& container)
+		{
+			auto owner = std::make_shared<const Container>(std::move(container));
+			auto begin = std::begin(*owner);
+			auto end = std::end(*owner);
+			return detail::TRange<decltype(begin), std::shared_ptr<const Container>>{ begin, end, std::move(owner) };
+		}
+
+		// Maps the file read-only and views it as contiguous records of T, without
+		// copying. The mapping lives as long as the range or any pipeline built on it.
+		// Throws std::system_error if the file cannot be mapped and std::length_error
+		// if its size is not a multiple of sizeof(T).
+		template <class T>
+			requires std::is_trivially_copyable_v<T>
+		static auto from_mmap(const std::filesystem::path& path, MappedFile::Advice advice = MappedFile::Advice::Sequential)
+		{
+			auto file = std::make_shared<const MappedFile>(path, advice);
+			if (file->size() % sizeof(T) != 0)
+				throw std::length_error("from_mmap: file size is not a multiple of the record size");
+			const T* data = reinterpret_cast<const T*>(file->data());
+			return detail::TRange<const T*, std::shared_ptr<const MappedFile>>{ data, data + file->size() / sizeof(T), std::move(file) };
+		}
 	private:
 		constexpr Range() = default;
 	};
@@ -386,17 +3424,169 @@ namespace uutils::data_processing
 		std::invoke(std::forward<Func>(func), std::forward<Range>(range));
 	}
 
-	constexpr auto map(auto pred) { return [=](auto&& range) { return detail::map_impl(std::forward<decltype(range)>(range), pred); }; }
-	constexpr auto filter(auto pred) { return [=](auto&& range) { return detail::filter_impl(std::forward<decltype(range)>(range), pred); }; }
+	constexpr auto map(auto pred)
+	{
+		return detail::stage_factory(std::move(pred), [](auto&& range, auto&& func) { return detail::map_impl(std::forward<decltype(range)>(range), std::forward<decltype(func)>(func)); });
+	}
+	// Predicates for filter that run as SIMD compares over contiguous numeric data
+	template <class T> constexpr auto lt(T value) { return detail::ComparePredicate<simd::Compare::Less, T>{ value, value }; }
+	template <class T> constexpr auto le(T value) { return detail::ComparePredicate<simd::Compare::LessEqual, T>{ value, value }; }
+	template <class T> constexpr auto gt(T value) { return detail::ComparePredicate<simd::Compare::Greater, T>{ value, value }; }
+	template <class T> constexpr auto ge(T value) { return detail::ComparePredicate<simd::Compare::GreaterEqual, T>{ value, value }; }
+	template <class T> constexpr auto eq(T value) { return detail::ComparePredicate<simd::Compare::Equal, T>{ value, value }; }
+	template <class T> constexpr auto ne(T value) { return detail::ComparePredicate<simd::Compare::NotEqual, T>{ value, value }; }
+	// lo <= x && x <= hi
+	template <class T> constexpr auto between(T lo, T hi) { return detail::ComparePredicate<simd::Compare::Between, T>{ lo, hi }; }
+
+	// Calls func(const T&) on every element that passes, e.g. for logging or counting
+	constexpr auto inspect(auto func)
+	{
+		return detail::stage_factory(std::move(func), [](auto&& range, auto&& func) { return detail::inspect_impl(std::forward<decltype(range)>(range), std::forward<decltype(func)>(func)); });
+	}
+
+	// Wraps an adaptor such as map(f) so that into records the elements going in and out of it
+	// and the time spent in it. The probes hide SIMD block paths of the stage from the
+	// terminal, so profiled pipelines can be slower overall.
+	inline auto profile(Profile& into, std::string_view name, auto stage)
+	{
+		// The stage is registered when it is applied, which follows the order of the pipeline
+		return [&into, name = std::string(name), stage](auto&& range) { return detail::profile_impl(std::forward<decltype(range)>(range), into.add_stage(name), stage); };
+	}
+	// Returns stage itself, so the pipeline has no trace of profiling in it
+	constexpr auto profile(NoProfile, std::string_view, auto stage) { return stage; }
+	inline constexpr NoProfile no_profile{};
+
+	constexpr auto filter(auto pred)
+	{
+		return detail::stage_factory(std::move(pred), [](auto&& range, auto&& func) { return detail::filter_impl(std::forward<decltype(range)>(range), std::forward<decltype(func)>(func)); });
+	}
+	// filter that only accepts the compare predicates above
+	template <simd::Compare Op, class T>
+	constexpr auto filter_simd(detail::ComparePredicate<Op, T> pred) { return filter(pred); }
 	constexpr auto skip(std::integral auto skip) { return [=](auto&& range) { return detail::skip_impl(std::forward<decltype(range)>(range), skip); }; }
 	constexpr auto take(std::integral auto amount) { return [=](auto&& range) { return detail::take_impl(std::forward<decltype(range)>(range), amount); }; }
 	constexpr auto reverse() { return [=](auto&& range) { return detail::reverse_impl(std::forward<decltype(range)>(range)); }; }
-	template <std::integral T> constexpr auto range(T from, T count) { return detail::TEnumerate(from, from + count); }
+	constexpr auto cache() { return [=](auto&& range) { return detail::cache_impl(std::forward<decltype(range)>(range)); }; }
+	// Runs everything upstream on a separate thread, keeping up to about capacity elements in flight
+	constexpr auto buffered(std::size_t capacity = 4096) { return [=](auto&& range) { return detail::buffered_impl(std::forward<decltype(range)>(range), capacity); }; }
+	// std::span<const T> views of n consecutive elements, the last one may be shorter
+	constexpr auto chunk(std::size_t n) { return [=](auto&& range) { return detail::chunk_impl(std::forward<decltype(range)>(range), n); }; }
+	// std::span<const T> views of every w consecutive elements of a contiguous source
+	constexpr auto window(std::size_t w) { return [=](auto&& range) { return detail::window_impl(std::forward<decltype(range)>(range), w); }; }
+	// Sum, mean, min or max of every w consecutive elements, each in O(1) amortized time
+	// per element. Yields nothing if the range has fewer than w elements.
+	constexpr auto rolling_sum(std::size_t w) { return [=](auto&& range) { return detail::rolling_impl<detail::RollingSum, 0>(std::forward<decltype(range)>(range), w); }; }
+	constexpr auto rolling_mean(std::size_t w) { return [=](auto&& range) { return detail::rolling_impl<detail::RollingMean, 0>(std::forward<decltype(range)>(range), w); }; }
+	constexpr auto rolling_min(std::size_t w) { return [=](auto&& range) { return detail::rolling_impl<detail::RollingMin, 0>(std::forward<decltype(range)>(range), w); }; }
+	constexpr auto rolling_max(std::size_t w) { return [=](auto&& range) { return detail::rolling_impl<detail::RollingMax, 0>(std::forward<decltype(range)>(range), w); }; }
+	// Same with W known at compile time, which keeps the last W elements in a std::array instead of a std::vector
+	template <std::size_t W> constexpr auto rolling_sum() { return [=](auto&& range) { return detail::rolling_impl<detail::RollingSum, W>(std::forward<decltype(range)>(range), W); }; }
+	template <std::size_t W> constexpr auto rolling_mean() { return [=](auto&& range) { return detail::rolling_impl<detail::RollingMean, W>(std::forward<decltype(range)>(range), W); }; }
+	template <std::size_t W> constexpr auto rolling_min() { return [=](auto&& range) { return detail::rolling_impl<detail::RollingMin, W>(std::forward<decltype(range)>(range), W); }; }
+	template <std::size_t W> constexpr auto rolling_max() { return [=](auto&& range) { return detail::rolling_impl<detail::RollingMax, W>(std::forward<decltype(range)>(range), W); }; }
+	// Running fold op(op(init, x0), x1)... for every element, or with exclusive the
+	// fold before every element, starting with init
+	constexpr auto scan(auto op, auto init) { return [=](auto&& range) { return detail::scan_impl<false>(std::forward<decltype(range)>(range), op, init); }; }
+	constexpr auto scan(Exclusive, auto op, auto init) { return [=](auto&& range) { return detail::scan_impl<true>(std::forward<decltype(range)>(range), op, init); }; }
+	// func(std::span<const T> in, std::span<U> out) maps up to batch elements at once
+	template <class U> constexpr auto map_batch(auto func, std::size_t batch = detail::block_buffer_size)
+	{
+		return detail::stage_factory(std::move(func), [batch](auto&& range, auto&& func) { return detail::map_batch_impl<U>(std::forward<decltype(range)>(range), std::forward<decltype(func)>(func), batch); });
+	}
+	// std::pair<L, R> of the elements of both ranges in lock step, as long as the shorter one
+	constexpr auto zip(auto other) { return [=](auto&& range) { return detail::zip_impl(std::forward<decltype(range)>(range), decltype(other)(other)); }; }
+	// std::pair<L, R> for every left and right element with key_left(l) == key_right(r)
+	constexpr auto hash_join(auto other, auto key_left, auto key_right)
+	{
+		return [=](auto&& range) { return detail::hash_join_impl(std::forward<decltype(range)>(range), decltype(other)(other), key_left, key_right); };
+	}
+	template <std::integral T> constexpr auto range(T from, T count) { return detail::TEnumerate<T>(from, static_cast<T>(from + count)); }
+
+	// Zero-copy std::string_view pieces of a contiguous char range
+	constexpr auto lines() { return [=](auto&& range) { return detail::split_impl<true>(std::forward<decltype(range)>(range), '\n'); }; }
+	constexpr auto split(char delim) { return [=](auto&& range) { return detail::split_impl<false>(std::forward<decltype(range)>(range), delim); }; }
 
 	constexpr auto to_vector() { return[=](auto&& range) { return detail::to_vector_impl(range); }; }
+	// The allocator is rebound to the element type, so e.g. uutils::ArenaAllocator<std::byte>(arena) works for any pipeline
+	constexpr auto to_vector(const detail::AllocatorLike auto& allocator) { return [=](auto&& range) { return detail::to_vector_impl(range, allocator); }; }
+	inline auto to_pmr_vector(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+	{
+		return [=](auto&& range) { return detail::to_vector_impl(range, std::pmr::polymorphic_allocator<std::byte>(resource)); };
+	}
 	constexpr auto print() { return[=](auto&& range) { detail::print_impl(range); }; }
+	// Calls func(std::span<const T>) for consecutive batches of the range
+	constexpr auto for_each_batch(auto func, std::size_t batch = detail::block_buffer_size) { return [=](auto&& range) { detail::for_each_batch_impl(range, func, batch); }; }
+	// Calls func(item) for every element; over Range::from_mut items are mutable references
+	constexpr auto for_each(auto func) { return [=](auto&& range) { detail::for_each_impl(range, func); }; }
+	// Replaces every element of a mutable range with func(element)
+	constexpr auto transform_inplace(auto func) { return [=](auto&& range) { detail::transform_inplace_impl(range, func); }; }
 	constexpr auto sum() { return [=](auto&& range) { return detail::sum_impl(range); }; }
 	constexpr auto all(auto&& func) { return [=](auto&& range) { return detail::all_impl(range, func); }; }
 	constexpr auto any(auto&& func) { return [=](auto&& range) { return detail::any_impl(range, func); }; }
 	constexpr auto none(auto&& func) { return [=](auto&& range) { return detail::none_impl(range, func); }; }
+	constexpr auto min() { return [=](auto&& range) { return detail::min_impl(range); }; }
+	constexpr auto max() { return [=](auto&& range) { return detail::max_impl(range); }; }
+	constexpr auto minmax() { return [=](auto&& range) { return detail::minmax_impl(range); }; }
+	constexpr auto count() { return [=](auto&& range) { return detail::count_impl(range); }; }
+	constexpr auto count(auto&& func) { return [=](auto&& range) { return detail::count_impl(range, func); }; }
+
+	// Aggregates by key into a uutils::FlatHashMap<Key, Acc>, e.g. group_by(key, agg::sum(&Row::bytes)).
+	// expected_groups presizes the map, by default up to 1024 groups are reserved for sized ranges.
+	constexpr auto group_by(auto key_func, auto agg, std::size_t expected_groups = 0) { return [=](auto&& range) { return detail::group_by_impl(range, key_func, agg, expected_groups); }; }
+
+	// The N largest elements by cmp, largest first, in a uutils::StaticVector<T, N> (fewer if the range is shorter)
+	template <std::size_t N, class Compare = std::less<>> constexpr auto top_k(Compare cmp = {}) { return [=](auto&& range) { return detail::top_k_impl<N>(range, cmp); }; }
+	// The N smallest elements by cmp, smallest first
+	template <std::size_t N, class Compare = std::less<>> constexpr auto bottom_k(Compare cmp = {}) { return top_k<N>([=](const auto& a, const auto& b) { return cmp(b, a); }); }
+	// Same with k known at run time, collected into a std::vector<T> of at most k elements
+	template <class Compare = std::less<>> constexpr auto top_k(std::size_t k, Compare cmp = {}) { return [=](auto&& range) { return detail::top_k_impl(range, k, cmp); }; }
+	template <class Compare = std::less<>> constexpr auto bottom_k(std::size_t k, Compare cmp = {}) { return top_k(k, [=](const auto& a, const auto& b) { return cmp(b, a); }); }
+
+	// Collects into an ascending std::vector<T>. Integer elements or keys keep equal keys in
+	// order, and are radix sorted from 256 elements on; otherwise the order of equal
+	// elements is unspecified.
+	constexpr auto sorted_by_key(auto key) { return [=](auto&& range) { return detail::sorted_by_key_impl(range, key); }; }
+	constexpr auto sorted() { return sorted_by_key(std::identity{}); }
+	constexpr auto sorted_by(auto cmp) { return [=](auto&& range) { return detail::sorted_by_impl(range, cmp); }; }
+
+	// Collects into a uutils::StaticVector<T, N>, throwing std::length_error if the range has more than N elements
+	template <std::size_t N> constexpr auto to_static_vector() { return [=](auto&& range) { return detail::to_static_vector_impl<N, false>(range); }; }
+	template <std::size_t N> constexpr auto to_static_vector(Truncate) { return [=](auto&& range) { return detail::to_static_vector_impl<N, true>(range); }; }
+
+	// Collects into a uutils::SmallVector<T, N>, which only allocates when there are more than N elements
+	template <std::size_t N> constexpr auto to_small_vector() { return [=](auto&& range) { return detail::to_small_vector_impl<N>(range); }; }
+
+	// Writes into caller-owned storage: an output iterator, or anything std::span can view (arrays,
+	// vectors, spans), which is filled from the front and must be large enough unless truncating is given
+	constexpr auto into(auto&& output)
+	{
+		if constexpr (std::input_or_output_iterator<std::remove_cvref_t<decltype(output)>>)
+			return [out = output](auto&& range) { return detail::into_impl(range, out); };
+		else
+			return [out = std::span(output)](auto&& range) { return detail::into_impl<false>(range, out); };
+	}
+	constexpr auto into(auto&& output, Truncate) { return [out = std::span(output)](auto&& range) { return detail::into_impl<true>(range, out); }; }
+
+	inline constexpr Reassociate reassociate{};
+	inline constexpr Truncate truncating{};
+	inline constexpr Exclusive exclusive{};
+	constexpr auto sum(Reassociate) { return [=](auto&& range) { return detail::sum_impl(range, reassociate); }; }
+	// Running totals in a std::vector<T>, or with exclusive the totals before every element
+	// starting with 0, e.g. offsets from lengths. Contiguous integers are scanned with SIMD.
+	constexpr auto to_prefix_sums() { return [=](auto&& range) { return detail::to_prefix_sums_impl<false>(range); }; }
+	constexpr auto to_prefix_sums(Exclusive) { return [=](auto&& range) { return detail::to_prefix_sums_impl<true>(range); }; }
+
+	inline constexpr ParallelPolicy par{};
+	constexpr ParallelPolicy parallel(std::size_t threads) { return ParallelPolicy{ threads }; }
+
+	constexpr auto to_vector(ParallelPolicy policy) { return [=](auto&& range) { return detail::to_vector_impl(range, policy); }; }
+	constexpr auto to_prefix_sums(ParallelPolicy policy) { return [=](auto&& range) { return detail::to_prefix_sums_impl<false>(range, policy); }; }
+	constexpr auto to_prefix_sums(ParallelPolicy policy, Exclusive) { return [=](auto&& range) { return detail::to_prefix_sums_impl<true>(range, policy); }; }
+	constexpr auto sum(ParallelPolicy policy) { return [=](auto&& range) { return detail::sum_impl(range, policy); }; }
+	constexpr auto for_each(ParallelPolicy policy, auto func) { return [=](auto&& range) { detail::for_each_impl(range, policy, func); }; }
+	constexpr auto transform_inplace(ParallelPolicy policy, auto func) { return [=](auto&& range) { detail::transform_inplace_impl(range, policy, func); }; }
+	constexpr auto all(ParallelPolicy policy, auto&& func) { return [=](auto&& range) { return detail::all_impl(range, policy, func); }; }
+	constexpr auto any(ParallelPolicy policy, auto&& func) { return [=](auto&& range) { return detail::any_impl(range, policy, func); }; }
+	constexpr auto none(ParallelPolicy policy, auto&& func) { return [=](auto&& range) { return detail::none_impl(range, policy, func); }; }
+	constexpr auto group_by(ParallelPolicy policy, auto key_func, auto agg, std::size_t expected_groups = 0) { return [=](auto&& range) { return detail::group_by_impl(range, policy, key_func, agg, expected_groups); }; }
 }
\ No newline at end of file
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace uutils
+{
+	// Open-addressing hash map with linear probing. Entries live in one flat array
+	// next to an array of control bytes holding 7 bits of each entry's hash, so a
+	// probe only touches a key when its fingerprint matches. Erase shifts the rest
+	// of the probe run back instead of leaving tombstones.
+	//
+	// Iterators and references are invalidated by any insertion that grows the
+	// table and by erase. Keys must not be modified through iterators.
+	template <class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+	class FlatHashMap
+	{
+	public:
+		using key_type = K;
+		using mapped_type = V;
+		using value_type = std::pair<K, V>;
+		using size_type = std::size_t;
+
+		template <bool Const>
+		class Iterator
+		{
+		public:
+			using Map = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+			using value_type = FlatHashMap::value_type;
+			using reference = std::conditional_t<Const, const value_type&, value_type&>;
+			using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			Iterator() = default;
+			Iterator(Map* map, size_type index) : _map(map), _index(index) { skip_empty(); }
+			operator Iterator<true>() const requires (!Const) { return Iterator<true>(_map, _index); }
+
+			reference operator*() const { return _map->_slots[_index]; }
+			pointer operator->() const { return &_map->_slots[_index]; }
+			Iterator& operator++() { ++_index; skip_empty(); return *this; }
+			Iterator operator++(int) { auto tmp = *this; ++(*this); return tmp; }
+			bool operator==(const Iterator& other) const { return _index == other._index; }
+			bool operator!=(const Iterator& other) const { return _index != other._index; }
+
+		private:
+			Map* _map = nullptr;
+			size_type _index = 0;
+
+			void skip_empty()
+			{
+				while (_index < _map->_capacity && _map->_ctrl[_index] == empty_slot) ++_index;
+			}
+
+			friend class FlatHashMap;
+		};
+
+		using iterator = Iterator<false>;
+		using const_iterator = Iterator<true>;
+
+		FlatHashMap() = default;
+		explicit FlatHashMap(size_type expected) { reserve(expected); }
+
+		FlatHashMap(const FlatHashMap& other) : _hash(other._hash), _equal(other._equal)
+		{
+			reserve(other._size);
+			for (const auto& [key, value] : other) try_emplace(key, value);
+		}
+
+		FlatHashMap(FlatHashMap&& other) noexcept
+			: _ctrl(std::exchange(other._ctrl, nullptr)), _slots(std::exchange(other._slots, nullptr)),
+			_capacity(std::exchange(other._capacity, 0)), _size(std::exchange(other._size, 0)), _shift(std::exchange(other._shift, 64)),
+			_hash(std::move(other._hash)), _equal(std::move(other._equal)) {
+		}
+
+		FlatHashMap& operator=(FlatHashMap other) noexcept
+		{
+			swap(other);
+			return *this;
+		}
+
+		~FlatHashMap() { release(); }
+
+		void swap(FlatHashMap& other) noexcept
+		{
+			std::swap(_ctrl, other._ctrl);
+			std::swap(_slots, other._slots);
+			std::swap(_capacity, other._capacity);
+			std::swap(_size, other._size);
+			std::swap(_shift, other._shift);
+			std::swap(_hash, other._hash);
+			std::swap(_equal, other._equal);
+		}
+
+		size_type size() const noexcept { return _size; }
+		bool empty() const noexcept { return _size == 0; }
+		size_type capacity() const noexcept { return _capacity; }
+
+		iterator begin() { return iterator(this, 0); }
+		iterator end() { return iterator(this, _capacity); }
+		const_iterator begin() const { return const_iterator(this, 0); }
+		const_iterator end() const { return const_iterator(this, _capacity); }
+
+		// Makes room for count entries without growing again
+		void reserve(size_type count)
+		{
+			size_type needed = std::max<size_type>(min_capacity, std::bit_ceil(count + count / 7 + 1));
+			if (needed > _capacity) rehash(needed);
+		}
+
+		void clear() noexcept
+		{
+			for (size_type i = 0; i < _capacity; ++i)
+			{
+				if (_ctrl[i] != empty_slot)
+				{
+					std::destroy_at(&_slots[i]);
+					_ctrl[i] = empty_slot;
+				}
+			}
+			_size = 0;
+		}
+
+		template <class... Args>
+		std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+		{
+			std::uint64_t h = hash_of(key);
+			if (size_type found = find_index(key, h); found != npos)
+				return { iterator(this, found), false };
+
+			if (_size + 1 > _capacity / 8 * 7) rehash(std::max<size_type>(min_capacity, _capacity * 2));
+			size_type index = home(h);
+			while (_ctrl[index] != empty_slot) index = (index + 1) & (_capacity - 1);
+			::new (static_cast<void*>(&_slots[index])) value_type(std::piecewise_construct,
+				std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+			_ctrl[index] = fingerprint(h);
+			++_size;
+			return { iterator(this, index), true };
+		}
+
+		template <class M>
+		std::pair<iterator, bool> insert_or_assign(const K& key, M&& value)
+		{
+			auto result = try_emplace(key, std::forward<M>(value));
+			if (!result.second) result.first->second = std::forward<M>(value);
+			return result;
+		}
+
+		V& operator[](const K& key) { return try_emplace(key).first->second; }
+
+		V& at(const K& key)
+		{
+			size_type index = find_index(key, hash_of(key));
+			if (index == npos) throw std::out_of_range("FlatHashMap::at");
+			return _slots[index].second;
+		}
+		const V& at(const K& key) const
+		{
+			size_type index = find_index(key, hash_of(key));
+			if (index == npos) throw std::out_of_range("FlatHashMap::at");
+			return _slots[index].second;
+		}
+
+		iterator find(const K& key)
+		{
+			size_type index = find_index(key, hash_of(key));
+			return index == npos ? end() : iterator(this, index);
+		}
+		const_iterator find(const K& key) const
+		{
+			size_type index = find_index(key, hash_of(key));
+			return index == npos ? end() : const_iterator(this, index);
+		}
+
+		bool contains(const K& key) const { return find_index(key, hash_of(key)) != npos; }
+
+		size_type erase(const K& key)
+		{
+			size_type index = find_index(key, hash_of(key));
+			if (index == npos) return 0;
+			erase_at(index);
+			return 1;
+		}
+
+	private:
+		static constexpr std::uint8_t empty_slot = 0;
+		static constexpr size_type min_capacity = 16;
+		static constexpr size_type npos = static_cast<size_type>(-1);
+
+		std::uint8_t* _ctrl = nullptr;
+		value_type* _slots = nullptr;
+		size_type _capacity = 0;
+		size_type _size = 0;
+		// 64 - log2(_capacity), for Fibonacci hashing
+		unsigned _shift = 64;
+		[[no_unique_address]] Hash _hash;
+		[[no_unique_address]] KeyEqual _equal;
+
+		// Spreads weak hashes such as std::hash<int> (the identity) over the high bits
+		std::uint64_t hash_of(const K& key) const { return static_cast<std::uint64_t>(_hash(key)) * 0x9E3779B97F4A7C15ull; }
+		size_type home(std::uint64_t h) const { return static_cast<size_type>(h >> _shift); }
+		static std::uint8_t fingerprint(std::uint64_t h) { return static_cast<std::uint8_t>(0x80 | (h & 0x7F)); }
+
+		size_type find_index(const K& key, std::uint64_t h) const
+		{
+			if (_size == 0) return npos;
+			std::uint8_t tag = fingerprint(h);
+			for (size_type index = home(h);; index = (index + 1) & (_capacity - 1))
+			{
+				if (_ctrl[index] == empty_slot) return npos;
+				if (_ctrl[index] == tag && _equal(_slots[index].first, key)) return index;
+			}
+		}
+
+		void erase_at(size_type hole)
+		{
+			std::destroy_at(&_slots[hole]);
+			_ctrl[hole] = empty_slot;
+			--_size;
+
+			// Pull back every later entry of the run that may live in the hole
+			size_type mask = _capacity - 1;
+			for (size_type next = (hole + 1) & mask; _ctrl[next] != empty_slot; next = (next + 1) & mask)
+			{
+				size_type ideal = home(hash_of(_slots[next].first));
+				// Can move iff its home is not in (hole, next], cyclically
+				if (((next - ideal) & mask) < ((next - hole) & mask)) continue;
+				::new (static_cast<void*>(&_slots[hole])) value_type(std::move(_slots[next]));
+				_ctrl[hole] = _ctrl[next];
+				std::destroy_at(&_slots[next]);
+				_ctrl[next] = empty_slot;
+				hole = next;
+			}
+		}
+
+		void rehash(size_type new_capacity)
+		{
+			auto* old_ctrl = _ctrl;
+			auto* old_slots = _slots;
+			size_type old_capacity = _capacity;
+
+			_ctrl = new std::uint8_t[new_capacity]();
+			try
+			{
+				_slots = static_cast<value_type*>(::operator new(new_capacity * sizeof(value_type), std::align_val_t{ alignof(value_type) }));
+			}
+			catch (...)
+			{
+				delete[] _ctrl;
+				_ctrl = old_ctrl;
+				throw;
+			}
+			_capacity = new_capacity;
+			_shift = 64 - static_cast<unsigned>(std::countr_zero(new_capacity));
+
+			for (size_type i = 0; i < old_capacity; ++i)
+			{
+				if (old_ctrl[i] == empty_slot) continue;
+				std::uint64_t h = hash_of(old_slots[i].first);
+				size_type index = home(h);
+				while (_ctrl[index] != empty_slot) index = (index + 1) & (_capacity - 1);
+				::new (static_cast<void*>(&_slots[index])) value_type(std::move(old_slots[i]));
+				_ctrl[index] = old_ctrl[i];
+				std::destroy_at(&old_slots[i]);
+			}
+			delete[] old_ctrl;
+			if (old_slots) ::operator delete(old_slots, std::align_val_t{ alignof(value_type) });
+		}
+
+		void release() noexcept
+		{
+			if (!_ctrl) return;
+			clear();
+			delete[] _ctrl;
+			::operator delete(_slots, std::align_val_t{ alignof(value_type) });
+			_ctrl = nullptr;
+			_slots = nullptr;
+			_capacity = 0;
+			_shift = 64;
+		}
+	};
+}
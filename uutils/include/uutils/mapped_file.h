@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace uutils
+{
+	// Read-only memory mapping of a whole file. The mapping is only backed by the
+	// page cache, so files larger than RAM are fine as long as they fit the
+	// address space.
+	class MappedFile
+	{
+	public:
+		enum class Advice
+		{
+			Normal,
+			// Aggressive readahead, pages behind the reader may be dropped early
+			Sequential,
+			// No readahead, for point lookups
+			Random,
+		};
+
+		// Throws std::system_error if the file cannot be opened or mapped
+		explicit MappedFile(const std::filesystem::path& path, Advice advice = Advice::Sequential);
+
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		~MappedFile();
+
+		const std::byte* data() const noexcept { return _data; }
+		std::size_t size() const noexcept { return _size; }
+
+		void advise(Advice advice) const noexcept;
+		// Asks the OS to start reading [offset, offset + length) in the background
+		void prefetch(std::size_t offset, std::size_t length) const noexcept;
+
+	private:
+		const std::byte* _data = nullptr;
+		std::size_t _size = 0;
+#ifdef _WIN32
+		void* _mapping = nullptr;
+#endif
+
+		void unmap() noexcept;
+	};
+}
@@ -0,0 +1,525 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define UUTILS_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define UUTILS_SIMD_X86 0
+#endif
+
+// Code between these markers is compiled for AVX2 and must only be reached
+// after has_avx2() returned true.
+#if defined(__clang__)
+#define UUTILS_SIMD_AVX2_BEGIN _Pragma("clang attribute push (__attribute__((target(\"avx2\"))), apply_to = function)")
+#define UUTILS_SIMD_AVX2_END _Pragma("clang attribute pop")
+#elif defined(__GNUC__)
+#define UUTILS_SIMD_AVX2_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx2\")")
+#define UUTILS_SIMD_AVX2_END _Pragma("GCC pop_options")
+#else
+#define UUTILS_SIMD_AVX2_BEGIN
+#define UUTILS_SIMD_AVX2_END
+#endif
+
+namespace uutils::simd
+{
+	// Element types with hand-written kernels; anything else goes through the scalar path
+	template <class T>
+	concept Vectorizable = std::is_same_v<T, float> || std::is_same_v<T, double>
+		|| (std::is_integral_v<T> && std::is_signed_v<T> && (sizeof(T) == 4 || sizeof(T) == 8));
+
+	enum class Compare
+	{
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+		Equal,
+		NotEqual,
+		// a <= x && x <= b
+		Between,
+	};
+
+	// Scalar form of the comparisons select() vectorizes
+	template <Compare Op, class T, class U>
+	constexpr bool compare(const T& x, const U& a, const U& b)
+	{
+		if constexpr (Op == Compare::Less) return x < a;
+		else if constexpr (Op == Compare::LessEqual) return x <= a;
+		else if constexpr (Op == Compare::Greater) return x > a;
+		else if constexpr (Op == Compare::GreaterEqual) return x >= a;
+		else if constexpr (Op == Compare::Equal) return x == a;
+		else if constexpr (Op == Compare::NotEqual) return x != a;
+		else return a <= x && x <= b;
+	}
+
+	inline bool has_avx2() noexcept
+	{
+#if UUTILS_SIMD_X86
+		static const bool supported = []
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7) return false;
+			__cpuid(info, 1);
+			bool osxsave = (info[2] & (1 << 27)) != 0;
+			bool avx = (info[2] & (1 << 28)) != 0;
+			if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") != 0;
+#endif
+		}();
+		return supported;
+#else
+		return false;
+#endif
+	}
+
+	namespace detail
+	{
+		template <class T>
+		T scalar_sum(const T* data, std::size_t size)
+		{
+			if constexpr (std::is_integral_v<T>)
+			{
+				// One wrapping accumulator at least as wide as int, narrowed once at the end.
+				// Narrow per-lane accumulators get miscompiled by GCC 12's vectorizer at -O3.
+				using Acc = std::make_unsigned_t<std::common_type_t<T, int>>;
+				Acc acc = 0;
+				for (std::size_t i = 0; i < size; ++i) acc += static_cast<Acc>(data[i]);
+				return static_cast<T>(acc);
+			}
+			else
+			{
+				T a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+				std::size_t i = 0;
+				for (; i + 4 <= size; i += 4)
+				{
+					a0 += data[i];
+					a1 += data[i + 1];
+					a2 += data[i + 2];
+					a3 += data[i + 3];
+				}
+				for (; i < size; ++i) a0 += data[i];
+				return (a0 + a1) + (a2 + a3);
+			}
+		}
+
+		template <class T>
+		void scalar_minmax(const T* data, std::size_t size, T& out_min, T& out_max)
+		{
+			T lo = data[0];
+			T hi = data[0];
+			for (std::size_t i = 1; i < size; ++i)
+			{
+				lo = data[i] < lo ? data[i] : lo;
+				hi = data[i] > hi ? data[i] : hi;
+			}
+			out_min = lo;
+			out_max = hi;
+		}
+
+		// Branch-free: every index is written, but the cursor only moves past matches
+		template <Compare Op, class T>
+		std::size_t scalar_select(const T* data, std::size_t size, T a, T b, std::uint32_t* out)
+		{
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				out[count] = static_cast<std::uint32_t>(i);
+				count += compare<Op>(data[i], a, b) ? 1 : 0;
+			}
+			return count;
+		}
+
+		template <class T>
+		T scalar_prefix_sum(const T* data, T* out, std::size_t size, T carry)
+		{
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				carry += data[i];
+				out[i] = carry;
+			}
+			return carry;
+		}
+
+#if UUTILS_SIMD_X86
+		namespace sse2
+		{
+			struct F32
+			{
+				using scalar = float;
+				using reg = __m128;
+				static constexpr std::size_t width = 4;
+				static constexpr bool has_minmax = true;
+				static reg zero() { return _mm_setzero_ps(); }
+				static reg set1(float v) { return _mm_set1_ps(v); }
+				static reg load(const float* p) { return _mm_loadu_ps(p); }
+				static void store(float* p, reg v) { _mm_storeu_ps(p, v); }
+				static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+				static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+				static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+				static constexpr bool has_compare = true;
+				static std::uint32_t lt(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(a, b))); }
+				static std::uint32_t le(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmple_ps(a, b))); }
+				static std::uint32_t gt(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmpgt_ps(a, b))); }
+				static std::uint32_t ge(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(a, b))); }
+				static std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+				static std::uint32_t ne(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmpneq_ps(a, b))); }
+			};
+
+			struct F64
+			{
+				using scalar = double;
+				using reg = __m128d;
+				static constexpr std::size_t width = 2;
+				static constexpr bool has_minmax = true;
+				static reg zero() { return _mm_setzero_pd(); }
+				static reg set1(double v) { return _mm_set1_pd(v); }
+				static reg load(const double* p) { return _mm_loadu_pd(p); }
+				static void store(double* p, reg v) { _mm_storeu_pd(p, v); }
+				static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+				static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+				static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+				static constexpr bool has_compare = true;
+				static std::uint32_t lt(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_cmplt_pd(a, b))); }
+				static std::uint32_t le(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_cmple_pd(a, b))); }
+				static std::uint32_t gt(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_cmpgt_pd(a, b))); }
+				static std::uint32_t ge(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_cmpge_pd(a, b))); }
+				static std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+				static std::uint32_t ne(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_cmpneq_pd(a, b))); }
+			};
+
+			template <class T>
+			struct I32
+			{
+				using scalar = T;
+				using reg = __m128i;
+				static constexpr std::size_t width = 4;
+				static constexpr bool has_minmax = true;
+				static reg zero() { return _mm_setzero_si128(); }
+				static reg set1(T v) { return _mm_set1_epi32(static_cast<int>(v)); }
+				static reg load(const T* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+				static void store(T* p, reg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+				static reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+				// SSE2 has no pminsd/pmaxsd, so select through a compare mask
+				static reg min(reg a, reg b)
+				{
+					reg mask = _mm_cmpgt_epi32(a, b);
+					return _mm_or_si128(_mm_and_si128(mask, b), _mm_andnot_si128(mask, a));
+				}
+				static reg max(reg a, reg b)
+				{
+					reg mask = _mm_cmpgt_epi32(a, b);
+					return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+				}
+				static constexpr bool has_compare = true;
+				static std::uint32_t bits(reg mask) { return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(mask))); }
+				static std::uint32_t lt(reg a, reg b) { return bits(_mm_cmplt_epi32(a, b)); }
+				static std::uint32_t le(reg a, reg b) { return gt(a, b) ^ 0xF; }
+				static std::uint32_t gt(reg a, reg b) { return bits(_mm_cmpgt_epi32(a, b)); }
+				static std::uint32_t ge(reg a, reg b) { return lt(a, b) ^ 0xF; }
+				static std::uint32_t eq(reg a, reg b) { return bits(_mm_cmpeq_epi32(a, b)); }
+				static std::uint32_t ne(reg a, reg b) { return eq(a, b) ^ 0xF; }
+				// Running totals across the lanes, and the last lane in every lane
+				static reg scan(reg x)
+				{
+					x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+					return _mm_add_epi32(x, _mm_slli_si128(x, 8));
+				}
+				static reg last(reg x) { return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3)); }
+			};
+
+			template <class T>
+			struct I64
+			{
+				using scalar = T;
+				using reg = __m128i;
+				static constexpr std::size_t width = 2;
+				// 64-bit compares need SSE4.2
+				static constexpr bool has_minmax = false;
+				static constexpr bool has_compare = false;
+				static reg zero() { return _mm_setzero_si128(); }
+				static reg set1(T v) { return _mm_set1_epi64x(static_cast<long long>(v)); }
+				static reg scan(reg x) { return _mm_add_epi64(x, _mm_slli_si128(x, 8)); }
+				static reg last(reg x) { return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2)); }
+				static reg load(const T* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+				static void store(T* p, reg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+				static reg add(reg a, reg b) { return _mm_add_epi64(a, b); }
+			};
+
+			struct Bytes
+			{
+				using reg = __m128i;
+				static constexpr std::size_t width = 16;
+				static reg set1(char v) { return _mm_set1_epi8(v); }
+				static reg load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+				static std::uint32_t eq_mask(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))); }
+			};
+
+			template <class T>
+			using Vec = std::conditional_t<std::is_same_v<T, float>, F32,
+				std::conditional_t<std::is_same_v<T, double>, F64,
+				std::conditional_t<sizeof(T) == 4, I32<T>, I64<T>>>>;
+
+#include "simd_kernels.inl"
+		}
+
+		UUTILS_SIMD_AVX2_BEGIN
+		namespace avx2
+		{
+			struct F32
+			{
+				using scalar = float;
+				using reg = __m256;
+				static constexpr std::size_t width = 8;
+				static constexpr bool has_minmax = true;
+				static reg zero() { return _mm256_setzero_ps(); }
+				static reg set1(float v) { return _mm256_set1_ps(v); }
+				static reg load(const float* p) { return _mm256_loadu_ps(p); }
+				static void store(float* p, reg v) { _mm256_storeu_ps(p, v); }
+				static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+				static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+				static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+				static constexpr bool has_compare = true;
+				static std::uint32_t lt(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ))); }
+				static std::uint32_t le(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ))); }
+				static std::uint32_t gt(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ))); }
+				static std::uint32_t ge(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GE_OQ))); }
+				static std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+				static std::uint32_t ne(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ))); }
+			};
+
+			struct F64
+			{
+				using scalar = double;
+				using reg = __m256d;
+				static constexpr std::size_t width = 4;
+				static constexpr bool has_minmax = true;
+				static reg zero() { return _mm256_setzero_pd(); }
+				static reg set1(double v) { return _mm256_set1_pd(v); }
+				static reg load(const double* p) { return _mm256_loadu_pd(p); }
+				static void store(double* p, reg v) { _mm256_storeu_pd(p, v); }
+				static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+				static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+				static reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+				static constexpr bool has_compare = true;
+				static std::uint32_t lt(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ))); }
+				static std::uint32_t le(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ))); }
+				static std::uint32_t gt(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ))); }
+				static std::uint32_t ge(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GE_OQ))); }
+				static std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))); }
+				static std::uint32_t ne(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_NEQ_UQ))); }
+			};
+
+			template <class T>
+			struct I32
+			{
+				using scalar = T;
+				using reg = __m256i;
+				static constexpr std::size_t width = 8;
+				static constexpr bool has_minmax = true;
+				static reg zero() { return _mm256_setzero_si256(); }
+				static reg set1(T v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+				static reg load(const T* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+				static void store(T* p, reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+				static reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+				static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+				static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+				static constexpr bool has_compare = true;
+				static std::uint32_t bits(reg mask) { return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(mask))); }
+				static std::uint32_t lt(reg a, reg b) { return bits(_mm256_cmpgt_epi32(b, a)); }
+				static std::uint32_t le(reg a, reg b) { return gt(a, b) ^ 0xFF; }
+				static std::uint32_t gt(reg a, reg b) { return bits(_mm256_cmpgt_epi32(a, b)); }
+				static std::uint32_t ge(reg a, reg b) { return lt(a, b) ^ 0xFF; }
+				static std::uint32_t eq(reg a, reg b) { return bits(_mm256_cmpeq_epi32(a, b)); }
+				static std::uint32_t ne(reg a, reg b) { return eq(a, b) ^ 0xFF; }
+				// Byte shifts stay within 128-bit halves, so the low half's total is added to the high half last
+				static reg scan(reg x)
+				{
+					x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+					x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+					reg low_total = _mm256_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+					return _mm256_add_epi32(x, _mm256_permute2x128_si256(low_total, low_total, 0x08));
+				}
+				static reg last(reg x) { return _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7)); }
+			};
+
+			template <class T>
+			struct I64
+			{
+				using scalar = T;
+				using reg = __m256i;
+				static constexpr std::size_t width = 4;
+				static constexpr bool has_minmax = true;
+				static reg zero() { return _mm256_setzero_si256(); }
+				static reg set1(T v) { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+				static reg load(const T* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+				static void store(T* p, reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+				static reg add(reg a, reg b) { return _mm256_add_epi64(a, b); }
+				static reg min(reg a, reg b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+				static reg max(reg a, reg b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+				static constexpr bool has_compare = true;
+				static std::uint32_t bits(reg mask) { return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(mask))); }
+				static std::uint32_t lt(reg a, reg b) { return bits(_mm256_cmpgt_epi64(b, a)); }
+				static std::uint32_t le(reg a, reg b) { return gt(a, b) ^ 0xF; }
+				static std::uint32_t gt(reg a, reg b) { return bits(_mm256_cmpgt_epi64(a, b)); }
+				static std::uint32_t ge(reg a, reg b) { return lt(a, b) ^ 0xF; }
+				static std::uint32_t eq(reg a, reg b) { return bits(_mm256_cmpeq_epi64(a, b)); }
+				static std::uint32_t ne(reg a, reg b) { return eq(a, b) ^ 0xF; }
+				static reg scan(reg x)
+				{
+					// Lanes moved up by one, then by two, with zeros shifted in
+					x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 0)), zero(), 0x03));
+					return _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 0, 0, 0)), zero(), 0x0F));
+				}
+				static reg last(reg x) { return _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3)); }
+			};
+
+			struct Bytes
+			{
+				using reg = __m256i;
+				static constexpr std::size_t width = 32;
+				static reg set1(char v) { return _mm256_set1_epi8(v); }
+				static reg load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+				static std::uint32_t eq_mask(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))); }
+			};
+
+			template <class T>
+			using Vec = std::conditional_t<std::is_same_v<T, float>, F32,
+				std::conditional_t<std::is_same_v<T, double>, F64,
+				std::conditional_t<sizeof(T) == 4, I32<T>, I64<T>>>>;
+
+#include "simd_kernels.inl"
+		}
+		UUTILS_SIMD_AVX2_END
+#endif
+	}
+
+	// Sums with several independent accumulators, so floating point results may
+	// differ from a left-to-right sum in the last bits.
+	template <class T>
+	T sum(const T* data, std::size_t size)
+	{
+#if UUTILS_SIMD_X86
+		if constexpr (Vectorizable<T>)
+		{
+			if (has_avx2()) return detail::avx2::sum<detail::avx2::Vec<T>>(data, size);
+			return detail::sse2::sum<detail::sse2::Vec<T>>(data, size);
+		}
+		else
+#endif
+			return detail::scalar_sum(data, size);
+	}
+
+	// size must be non-zero. The result is unspecified if the data contains NaN.
+	template <class T>
+	std::pair<T, T> minmax(const T* data, std::size_t size)
+	{
+		std::pair<T, T> result;
+#if UUTILS_SIMD_X86
+		if constexpr (Vectorizable<T>)
+		{
+			if (has_avx2())
+				detail::avx2::minmax<detail::avx2::Vec<T>>(data, size, result.first, result.second);
+			else if constexpr (detail::sse2::Vec<T>::has_minmax)
+				detail::sse2::minmax<detail::sse2::Vec<T>>(data, size, result.first, result.second);
+			else
+				detail::scalar_minmax(data, size, result.first, result.second);
+		}
+		else
+#endif
+			detail::scalar_minmax(data, size, result.first, result.second);
+		return result;
+	}
+
+	// size must be non-zero. The result is unspecified if the data contains NaN.
+	template <class T>
+	T min(const T* data, std::size_t size)
+	{
+#if UUTILS_SIMD_X86
+		if constexpr (Vectorizable<T>)
+		{
+			if (has_avx2()) return detail::avx2::extreme<detail::avx2::Vec<T>, false>(data, size);
+			if constexpr (detail::sse2::Vec<T>::has_minmax)
+				return detail::sse2::extreme<detail::sse2::Vec<T>, false>(data, size);
+		}
+#endif
+		return minmax(data, size).first;
+	}
+
+	// size must be non-zero. The result is unspecified if the data contains NaN.
+	template <class T>
+	T max(const T* data, std::size_t size)
+	{
+#if UUTILS_SIMD_X86
+		if constexpr (Vectorizable<T>)
+		{
+			if (has_avx2()) return detail::avx2::extreme<detail::avx2::Vec<T>, true>(data, size);
+			if constexpr (detail::sse2::Vec<T>::has_minmax)
+				return detail::sse2::extreme<detail::sse2::Vec<T>, true>(data, size);
+		}
+#endif
+		return minmax(data, size).second;
+	}
+
+	// Writes the running totals of data, starting from carry, to out (which may be
+	// data) and returns the last one. Only integers are vectorized: a vectorized
+	// floating point scan would regroup the additions and change the results.
+	template <class T>
+	T prefix_sum(const T* data, T* out, std::size_t size, T carry = T(0))
+	{
+#if UUTILS_SIMD_X86
+		if constexpr (Vectorizable<T> && std::is_integral_v<T>)
+		{
+			if (has_avx2()) return detail::avx2::prefix_sum<detail::avx2::Vec<T>>(data, out, size, carry);
+			return detail::sse2::prefix_sum<detail::sse2::Vec<T>>(data, out, size, carry);
+		}
+		else
+#endif
+			return detail::scalar_prefix_sum(data, out, size, carry);
+	}
+
+	// First occurrence of c in [first, last), or last if there is none
+	inline const char* find_byte(const char* first, const char* last, char c)
+	{
+#if UUTILS_SIMD_X86
+		if (has_avx2()) return detail::avx2::find_byte<detail::avx2::Bytes>(first, last, c);
+		return detail::sse2::find_byte<detail::sse2::Bytes>(first, last, c);
+#else
+		if (first == last) return last;
+		auto* found = static_cast<const char*>(std::memchr(first, static_cast<unsigned char>(c), static_cast<std::size_t>(last - first)));
+		return found ? found : last;
+#endif
+	}
+
+	// Writes the indices of the elements x with compare<Op>(x, a, b) into out,
+	// which must have room for size indices, and returns how many there are.
+	// Selection does not branch on the data, so it costs the same at any selectivity.
+	template <Compare Op, class T>
+	std::size_t select(const T* data, std::size_t size, T a, T b, std::uint32_t* out)
+	{
+#if UUTILS_SIMD_X86
+		if constexpr (Vectorizable<T>)
+		{
+			if (has_avx2()) return detail::avx2::select<detail::avx2::Vec<T>, Op>(data, size, a, b, out);
+			if constexpr (detail::sse2::Vec<T>::has_compare)
+				return detail::sse2::select<detail::sse2::Vec<T>, Op>(data, size, a, b, out);
+		}
+#endif
+		return detail::scalar_select<Op>(data, size, a, b, out);
+	}
+}
@@ -0,0 +1,201 @@
+// Reduction kernels shared by every instruction set in simd.h. This file is
+// included once per target namespace, so V is always one of that target's
+// vector wrappers and the kernels get compiled for that target.
+
+template <class V>
+typename V::scalar sum(const typename V::scalar* data, std::size_t size)
+{
+	using T = typename V::scalar;
+	constexpr std::size_t W = V::width;
+
+	auto a0 = V::zero();
+	auto a1 = a0, a2 = a0, a3 = a0;
+	std::size_t i = 0;
+	for (; i + 4 * W <= size; i += 4 * W)
+	{
+		a0 = V::add(a0, V::load(data + i));
+		a1 = V::add(a1, V::load(data + i + W));
+		a2 = V::add(a2, V::load(data + i + 2 * W));
+		a3 = V::add(a3, V::load(data + i + 3 * W));
+	}
+	for (; i + W <= size; i += W)
+		a0 = V::add(a0, V::load(data + i));
+
+	T lanes[W];
+	V::store(lanes, V::add(V::add(a0, a1), V::add(a2, a3)));
+	T total = static_cast<T>(0);
+	for (T lane : lanes) total += lane;
+	for (; i < size; ++i) total += data[i];
+	return total;
+}
+
+// size must be non-zero
+template <class V>
+void minmax(const typename V::scalar* data, std::size_t size, typename V::scalar& out_min, typename V::scalar& out_max)
+{
+	using T = typename V::scalar;
+	constexpr std::size_t W = V::width;
+
+	T lo = data[0];
+	T hi = data[0];
+	std::size_t i = 0;
+	if (size >= 2 * W)
+	{
+		auto lo0 = V::set1(data[0]);
+		auto lo1 = lo0, hi0 = lo0, hi1 = lo0;
+		for (; i + 2 * W <= size; i += 2 * W)
+		{
+			auto x0 = V::load(data + i);
+			auto x1 = V::load(data + i + W);
+			lo0 = V::min(lo0, x0);
+			lo1 = V::min(lo1, x1);
+			hi0 = V::max(hi0, x0);
+			hi1 = V::max(hi1, x1);
+		}
+
+		T lanes[W];
+		V::store(lanes, V::min(lo0, lo1));
+		for (T lane : lanes) lo = lane < lo ? lane : lo;
+		V::store(lanes, V::max(hi0, hi1));
+		for (T lane : lanes) hi = lane > hi ? lane : hi;
+	}
+	for (; i < size; ++i)
+	{
+		lo = data[i] < lo ? data[i] : lo;
+		hi = data[i] > hi ? data[i] : hi;
+	}
+	out_min = lo;
+	out_max = hi;
+}
+
+template <class V, bool Max>
+typename V::reg pick(typename V::reg a, typename V::reg b)
+{
+	if constexpr (Max) return V::max(a, b);
+	else return V::min(a, b);
+}
+
+// size must be non-zero
+template <class V, bool Max>
+typename V::scalar extreme(const typename V::scalar* data, std::size_t size)
+{
+	using T = typename V::scalar;
+	constexpr std::size_t W = V::width;
+
+	T best = data[0];
+	std::size_t i = 0;
+	if (size >= 4 * W)
+	{
+		auto a0 = V::set1(data[0]);
+		auto a1 = a0, a2 = a0, a3 = a0;
+		for (; i + 4 * W <= size; i += 4 * W)
+		{
+			a0 = pick<V, Max>(a0, V::load(data + i));
+			a1 = pick<V, Max>(a1, V::load(data + i + W));
+			a2 = pick<V, Max>(a2, V::load(data + i + 2 * W));
+			a3 = pick<V, Max>(a3, V::load(data + i + 3 * W));
+		}
+
+		T lanes[W];
+		V::store(lanes, pick<V, Max>(pick<V, Max>(a0, a1), pick<V, Max>(a2, a3)));
+		for (T lane : lanes) best = (Max ? lane > best : lane < best) ? lane : best;
+	}
+	for (; i < size; ++i)
+		best = (Max ? data[i] > best : data[i] < best) ? data[i] : best;
+	return best;
+}
+
+// Integer vectors only. Each vector is scanned in registers and the running
+// total, kept broadcast to every lane, is added on. The total grows by the
+// vector's own last lane, so the chain from one vector to the next is one add.
+template <class V>
+typename V::scalar prefix_sum(const typename V::scalar* data, typename V::scalar* out, std::size_t size, typename V::scalar carry)
+{
+	using T = typename V::scalar;
+	constexpr std::size_t W = V::width;
+
+	std::size_t i = 0;
+	if (size >= W)
+	{
+		auto total = V::set1(carry);
+		for (; i + W <= size; i += W)
+		{
+			auto x = V::scan(V::load(data + i));
+			V::store(out + i, V::add(x, total));
+			total = V::add(total, V::last(x));
+		}
+		T lanes[W];
+		V::store(lanes, total);
+		carry = lanes[0];
+	}
+	for (; i < size; ++i)
+	{
+		carry += data[i];
+		out[i] = carry;
+	}
+	return carry;
+}
+
+// First byte equal to c in [first, last), or last
+template <class V>
+const char* find_byte(const char* first, const char* last, char c)
+{
+	constexpr std::size_t W = V::width;
+
+	auto needle = V::set1(c);
+	for (; static_cast<std::size_t>(last - first) >= 2 * W; first += 2 * W)
+	{
+		auto m0 = V::eq_mask(V::load(first), needle);
+		auto m1 = V::eq_mask(V::load(first + W), needle);
+		if (m0 | m1)
+			return m0 ? first + std::countr_zero(m0) : first + W + std::countr_zero(m1);
+	}
+	if (static_cast<std::size_t>(last - first) >= W)
+	{
+		if (auto m = V::eq_mask(V::load(first), needle)) return first + std::countr_zero(m);
+		first += W;
+	}
+	for (; first != last; ++first)
+		if (*first == c) return first;
+	return last;
+}
+
+template <class V, Compare Op>
+std::uint32_t compare_mask(typename V::reg x, typename V::reg a, typename V::reg b)
+{
+	if constexpr (Op == Compare::Less) return V::lt(x, a);
+	else if constexpr (Op == Compare::LessEqual) return V::le(x, a);
+	else if constexpr (Op == Compare::Greater) return V::gt(x, a);
+	else if constexpr (Op == Compare::GreaterEqual) return V::ge(x, a);
+	else if constexpr (Op == Compare::Equal) return V::eq(x, a);
+	else if constexpr (Op == Compare::NotEqual) return V::ne(x, a);
+	else return V::ge(x, a) & V::le(x, b);
+}
+
+// Compacts the indices of matching elements from a per-vector bitmask, writing
+// every lane and advancing the cursor by its bit so there is no branch per element
+template <class V, Compare Op>
+std::size_t select(const typename V::scalar* data, std::size_t size, typename V::scalar a, typename V::scalar b, std::uint32_t* out)
+{
+	constexpr std::size_t W = V::width;
+
+	auto va = V::set1(a);
+	auto vb = V::set1(b);
+	std::size_t count = 0;
+	std::size_t i = 0;
+	for (; i + W <= size; i += W)
+	{
+		std::uint32_t mask = compare_mask<V, Op>(V::load(data + i), va, vb);
+		for (std::size_t j = 0; j < W; ++j)
+		{
+			out[count] = static_cast<std::uint32_t>(i + j);
+			count += (mask >> j) & 1;
+		}
+	}
+	for (; i < size; ++i)
+	{
+		out[count] = static_cast<std::uint32_t>(i);
+		count += compare<Op>(data[i], a, b) ? 1 : 0;
+	}
+	return count;
+}
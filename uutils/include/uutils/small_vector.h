@@ -0,0 +1,286 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace uutils
+{
+	// Vector that keeps up to InlineCapacity elements inside the object and only
+	// moves to the heap once it outgrows them
+	template <class T, std::size_t InlineCapacity>
+	class SmallVector
+	{
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using iterator = pointer;
+		using const_iterator = const_pointer;
+
+		SmallVector() noexcept : _data(inline_data()), _size{ 0 }, _capacity{ InlineCapacity } {}
+		SmallVector(std::initializer_list<T> init) : SmallVector()
+		{
+			reserve(init.size());
+			for (const T& v : init) emplace_back(v);
+		}
+
+		SmallVector(const SmallVector& other) : SmallVector()
+		{
+			reserve(other._size);
+			std::uninitialized_copy(other.begin(), other.end(), _data);
+			_size = other._size;
+		}
+
+		SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVector()
+		{
+			take(std::move(other));
+		}
+
+		SmallVector& operator=(const SmallVector& other)
+		{
+			if (this != &other)
+			{
+				clear();
+				reserve(other._size);
+				std::uninitialized_copy(other.begin(), other.end(), _data);
+				_size = other._size;
+			}
+			return *this;
+		}
+
+		SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this != &other)
+			{
+				clear();
+				free_heap();
+				take(std::move(other));
+			}
+			return *this;
+		}
+
+		~SmallVector()
+		{
+			clear();
+			free_heap();
+		}
+
+		size_type size() const noexcept { return _size; }
+		size_type capacity() const noexcept { return _capacity; }
+		bool empty() const noexcept { return _size == 0; }
+		// Whether the elements still live in the inline storage
+		bool is_inline() const noexcept { return _data == inline_data(); }
+
+		pointer data() noexcept { return _data; }
+		const_pointer data() const noexcept { return _data; }
+
+		reference operator[](size_type index) { return _data[index]; }
+		const_reference operator[](size_type index) const { return _data[index]; }
+
+		reference at(size_type index)
+		{
+			if (index >= _size) throw std::out_of_range("SmallVector::at");
+			return _data[index];
+		}
+		const_reference at(size_type index) const
+		{
+			if (index >= _size) throw std::out_of_range("SmallVector::at");
+			return _data[index];
+		}
+
+		reference front() { return _data[0]; }
+		const_reference front() const { return _data[0]; }
+		reference back() { return _data[_size - 1]; }
+		const_reference back() const { return _data[_size - 1]; }
+
+		iterator begin() noexcept { return _data; }
+		const_iterator begin() const noexcept { return _data; }
+		const_iterator cbegin() const noexcept { return _data; }
+		iterator end() noexcept { return _data + _size; }
+		const_iterator end() const noexcept { return _data + _size; }
+		const_iterator cend() const noexcept { return _data + _size; }
+
+		template <typename... Args>
+		reference emplace_back(Args&&... args)
+		{
+			if (_size < _capacity)
+			{
+				T* p = ::new (static_cast<void*>(_data + _size)) T(std::forward<Args>(args)...);
+				++_size;
+				return *p;
+			}
+
+			// Construct before relocating, the arguments may refer to current elements
+			size_type new_capacity = grown_capacity(_size + 1);
+			T* new_data = allocate(new_capacity);
+			T* p;
+			try
+			{
+				p = ::new (static_cast<void*>(new_data + _size)) T(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				deallocate(new_data, new_capacity);
+				throw;
+			}
+			try
+			{
+				relocate(new_data, _data, _size);
+			}
+			catch (...)
+			{
+				std::destroy_at(p);
+				deallocate(new_data, new_capacity);
+				throw;
+			}
+			replace_buffer(new_data, new_capacity);
+			++_size;
+			return *p;
+		}
+
+		void push_back(const T& value) { emplace_back(value); }
+		void push_back(T&& value) { emplace_back(std::move(value)); }
+
+		void pop_back()
+		{
+			if (_size == 0) return;
+			--_size;
+			_data[_size].~T();
+		}
+
+		void clear() noexcept
+		{
+			std::destroy_n(_data, _size);
+			_size = 0;
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			size_type index = static_cast<size_type>(pos - _data);
+			if (index >= _size)
+				throw std::out_of_range("SmallVector::erase");
+
+			std::move(_data + index + 1, _data + _size, _data + index);
+			pop_back();
+			return _data + index;
+		}
+
+		void reserve(size_type new_capacity)
+		{
+			if (new_capacity <= _capacity) return;
+			move_to(allocate(new_capacity), new_capacity);
+		}
+
+		// Moves back into the inline storage when the elements fit there
+		void shrink_to_fit()
+		{
+			if (is_inline() || _capacity == _size) return;
+			if (_size <= InlineCapacity)
+			{
+				T* old = _data;
+				size_type old_capacity = _capacity;
+				relocate(inline_data(), old, _size);
+				deallocate(old, old_capacity);
+				_data = inline_data();
+				_capacity = InlineCapacity;
+				return;
+			}
+			move_to(allocate(_size), _size);
+		}
+
+	private:
+		T* _data;
+		size_type _size;
+		size_type _capacity;
+		alignas(T) std::byte _inline[sizeof(T) * (InlineCapacity > 0 ? InlineCapacity : 1)];
+
+		T* inline_data() noexcept { return reinterpret_cast<T*>(_inline); }
+		const T* inline_data() const noexcept { return reinterpret_cast<const T*>(_inline); }
+
+		static T* allocate(size_type capacity) { return static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t{ alignof(T) })); }
+		static void deallocate(T* p, size_type) noexcept { ::operator delete(p, std::align_val_t{ alignof(T) }); }
+
+		size_type grown_capacity(size_type required) const noexcept { return std::max(required, _capacity * 2); }
+
+		// Moves n elements from src into uninitialized dst and ends their lifetime in src.
+		// Elements whose move may throw are copied like std::move_if_noexcept does, so if
+		// that throws, dst holds nothing and src is untouched.
+		static void relocate(T* dst, T* src, size_type n) noexcept(std::is_trivially_copyable_v<T> || std::is_nothrow_move_constructible_v<T>)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				if (n != 0) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+			}
+			else
+			{
+				if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+					std::uninitialized_move_n(src, n, dst);
+				else
+					std::uninitialized_copy_n(src, n, dst);
+				std::destroy_n(src, n);
+			}
+		}
+
+		// Relocates the elements into new_data, or frees it and leaves this unchanged if that throws
+		void move_to(T* new_data, size_type new_capacity)
+		{
+			try
+			{
+				relocate(new_data, _data, _size);
+			}
+			catch (...)
+			{
+				deallocate(new_data, new_capacity);
+				throw;
+			}
+			replace_buffer(new_data, new_capacity);
+		}
+
+		void replace_buffer(T* new_data, size_type new_capacity) noexcept
+		{
+			free_heap();
+			_data = new_data;
+			_capacity = new_capacity;
+		}
+
+		void free_heap() noexcept
+		{
+			if (!is_inline())
+			{
+				deallocate(_data, _capacity);
+				_data = inline_data();
+				_capacity = InlineCapacity;
+			}
+		}
+
+		// Expects this to be empty and inline
+		void take(SmallVector&& other)
+		{
+			if (other.is_inline())
+			{
+				relocate(_data, other._data, other._size);
+				_size = other._size;
+			}
+			else
+			{
+				_data = other._data;
+				_size = other._size;
+				_capacity = other._capacity;
+				other._data = other.inline_data();
+				other._capacity = InlineCapacity;
+			}
+			other._size = 0;
+		}
+	};
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace uutils
+{
+	// Bounded lock-free queue for exactly one producer thread and one consumer
+	// thread. Each side caches the other side's index, so the shared cache lines
+	// are only touched when the queue looks full or empty.
+	template <class T>
+	class SpscRing
+	{
+	public:
+		// The capacity is rounded up to a power of two
+		explicit SpscRing(std::size_t capacity)
+			: _mask(std::bit_ceil(std::max<std::size_t>(capacity, 1)) - 1), _slots(std::make_unique<T[]>(_mask + 1)) {
+		}
+
+		SpscRing(const SpscRing&) = delete;
+		SpscRing& operator=(const SpscRing&) = delete;
+
+		std::size_t capacity() const noexcept { return _mask + 1; }
+
+		// Producer side. Moves value in and returns true, or leaves it untouched if the ring is full.
+		template <class U>
+		bool try_push(U&& value)
+		{
+			std::size_t tail = _tail.load(std::memory_order_relaxed);
+			if (tail - _cached_head > _mask)
+			{
+				_cached_head = _head.load(std::memory_order_acquire);
+				if (tail - _cached_head > _mask) return false;
+			}
+			_slots[tail & _mask] = std::forward<U>(value);
+			_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Consumer side. Moves the oldest element into out, or returns false if the ring is empty.
+		bool try_pop(T& out)
+		{
+			std::size_t head = _head.load(std::memory_order_relaxed);
+			if (head == _cached_tail)
+			{
+				_cached_tail = _tail.load(std::memory_order_acquire);
+				if (head == _cached_tail) return false;
+			}
+			out = std::move(_slots[head & _mask]);
+			_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+	private:
+		static constexpr std::size_t cache_line = 64;
+
+		// Written by the consumer
+		alignas(cache_line) std::atomic<std::size_t> _head{ 0 };
+		std::size_t _cached_tail = 0;
+		// Written by the producer
+		alignas(cache_line) std::atomic<std::size_t> _tail{ 0 };
+		std::size_t _cached_head = 0;
+
+		alignas(cache_line) const std::size_t _mask;
+		std::unique_ptr<T[]> _slots;
+	};
+}
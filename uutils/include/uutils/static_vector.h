@@ -1,8 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <bit>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
 #include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 
 namespace uutils
 {
@@ -24,12 +30,38 @@ namespace uutils
 			for (const T& v : init) emplace_back(v);
 		}
 
+		constexpr StaticVector(const StaticVector& other) : _size{ 0 } { copy_from(other); }
+		constexpr StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : _size{ 0 } { move_from(other); }
+
+		constexpr StaticVector& operator=(const StaticVector& other)
+		{
+			if (this != &other)
+			{
+				clear();
+				copy_from(other);
+			}
+			return *this;
+		}
+
+		constexpr StaticVector& operator=(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this != &other)
+			{
+				clear();
+				move_from(other);
+			}
+			return *this;
+		}
+
 		constexpr ~StaticVector() { clear(); }
 
 		constexpr size_type size() const { return _size; }
 		constexpr size_type capacity() const { return Capacity; }
 		constexpr bool empty() const noexcept { return _size == 0; }
 
+		constexpr pointer data() noexcept { return ptr(0); }
+		constexpr const_pointer data() const noexcept { return ptr(0); }
+
 		constexpr reference operator[](size_type index) { return *ptr(index); }
 		constexpr const_reference operator[](size_type index) const { return *ptr(index); }
 
@@ -70,11 +102,26 @@ namespace uutils
 
 		constexpr void clear()
 		{
-			for (size_type i = 0; i < _size; ++i)
-				ptr(i)->~T();
+			std::destroy(ptr(0), ptr(_size));
 			_size = 0;
 		}
 
+		constexpr void resize(size_type count) { resize_with(count, [this] { emplace_back(); }); }
+		constexpr void resize(size_type count, const T& value) { resize_with(count, [&] { emplace_back(value); }); }
+
+		constexpr void assign(size_type count, const T& value)
+		{
+			clear();
+			resize(count, value);
+		}
+		template <std::input_iterator It>
+		constexpr void assign(It first, It last)
+		{
+			clear();
+			insert(cend(), first, last);
+		}
+		constexpr void assign(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
 		template <typename U>
 		struct Iterator
 		{
@@ -85,9 +132,11 @@ namespace uutils
 			using iterator_category = std::random_access_iterator_tag;
 
 			using RawStoragePtr = std::conditional_t<std::is_const_v<U>, const Storage*, Storage*>;
-			RawStoragePtr _ptr;
+			RawStoragePtr _ptr = nullptr;
 
+			constexpr Iterator() = default;
 			constexpr Iterator(RawStoragePtr ptr) : _ptr(ptr) {}
+			constexpr operator Iterator<const U>() const requires (!std::is_const_v<U>) { return Iterator<const U>(_ptr); }
 			constexpr reference operator*() const { return *std::bit_cast<pointer>(_ptr); }
 			constexpr pointer operator->() const { return std::bit_cast<pointer>(_ptr); }
 			constexpr Iterator& operator++() { ++_ptr; return *this; }
@@ -114,29 +163,150 @@ namespace uutils
 
 		constexpr iterator erase(const_iterator pos)
 		{
-			size_type index = static_cast<size_type>(pos._ptr - &_data[0]);
-			if (index >= _size)
+			if (index_of(pos) >= _size)
 				throw std::out_of_range("StaticVector::erase");
-			ptr(index)->~T();
+			return erase(pos, pos + 1);
+		}
+		constexpr iterator erase(iterator pos) { return erase(const_iterator(pos._ptr)); }
 
-			for (size_type i = index; i + 1 < _size; ++i) {
-				T* dst = ptr(i);
-				T* src = ptr(i + 1);
+		constexpr iterator erase(const_iterator first, const_iterator last)
+		{
+			size_type from = index_of(first);
+			size_type to = index_of(last);
+			if (from > to || to > _size)
+				throw std::out_of_range("StaticVector::erase");
 
-				new (dst) T(std::move(*src));
-				src->~T();
+			size_type count = to - from;
+			if (count != 0)
+			{
+				if constexpr (std::is_trivially_copyable_v<T>)
+					std::memmove(static_cast<void*>(ptr(from)), static_cast<const void*>(ptr(to)), (_size - to) * sizeof(T));
+				else
+				{
+					std::move(ptr(to), ptr(_size), ptr(from));
+					std::destroy(ptr(_size - count), ptr(_size));
+				}
+				_size -= count;
 			}
+			return iterator(&_data[from]);
+		}
 
-			--_size;
+		// Removes every element matching pred in a single pass, keeping the order of the rest
+		template <class Pred>
+		constexpr size_type erase_if(Pred pred)
+		{
+			T* last = ptr(_size);
+			T* new_last = std::remove_if(ptr(0), last, pred);
+			size_type removed = static_cast<size_type>(last - new_last);
+			std::destroy(new_last, last);
+			_size -= removed;
+			return removed;
+		}
+
+		// O(1) erase that moves the last element into pos, so the order is not kept
+		constexpr iterator unordered_erase(const_iterator pos)
+		{
+			size_type index = index_of(pos);
+			if (index >= _size)
+				throw std::out_of_range("StaticVector::unordered_erase");
+			if (index + 1 != _size)
+				*ptr(index) = std::move(back());
+			pop_back();
 			return iterator(&_data[index]);
 		}
-		constexpr iterator erase(iterator pos) { return erase(const_iterator(pos._ptr)); }
+
+		template <std::input_iterator It>
+		constexpr iterator insert(const_iterator pos, It first, It last)
+		{
+			size_type index = index_of(pos);
+			if (index > _size)
+				throw std::out_of_range("StaticVector::insert");
+
+			if constexpr (std::forward_iterator<It>)
+			{
+				auto count = static_cast<size_type>(std::distance(first, last));
+				if (count > Capacity - _size)
+					throw std::length_error("StaticVector capacity exceeded");
+				// Shifts the tail up with one memmove. Only for sources known by address, which
+				// may lie in this vector and have to be read from where the shift left them.
+				if constexpr (std::is_trivially_copyable_v<T> && (std::contiguous_iterator<It> || std::is_same_v<It, iterator> || std::is_same_v<It, const_iterator>))
+				{
+					if (count == 0) return iterator(&_data[index]);
+					const T* src = std::to_address(first);
+					std::size_t before = count;
+					std::size_t shifted = 0;
+					if (std::less_equal<>()(ptr(0), src) && std::less<>()(src, ptr(_size)))
+					{
+						// Source elements from index on move up by count with the tail
+						before = src < ptr(index) ? std::min<std::size_t>(count, static_cast<std::size_t>(ptr(index) - src)) : 0;
+						shifted = count;
+					}
+					std::memmove(static_cast<void*>(ptr(index + count)), static_cast<const void*>(ptr(index)), (_size - index) * sizeof(T));
+					std::memcpy(static_cast<void*>(ptr(index)), static_cast<const void*>(src), before * sizeof(T));
+					std::memcpy(static_cast<void*>(ptr(index + before)), static_cast<const void*>(src + before + shifted), (count - before) * sizeof(T));
+					_size += count;
+					return iterator(&_data[index]);
+				}
+			}
+
+			// Append, then rotate the new elements into place. Reading the source while
+			// appending is safe even if it lies in this vector, which never reallocates.
+			size_type old_size = _size;
+			try
+			{
+				for (; first != last; ++first) emplace_back(*first);
+			}
+			catch (...)
+			{
+				std::destroy(ptr(old_size), ptr(_size));
+				_size = old_size;
+				throw;
+			}
+			std::rotate(ptr(index), ptr(old_size), ptr(_size));
+			return iterator(&_data[index]);
+		}
+		constexpr iterator insert(const_iterator pos, std::initializer_list<T> init) { return insert(pos, init.begin(), init.end()); }
 
 	private:
 		std::aligned_storage_t<sizeof(T), alignof(T)> _data[Capacity];
 		size_type _size;
 
-		constexpr T* ptr(size_type index) noexcept { return std::bit_cast<T*>(&_data[index]); }
-		constexpr const T* ptr(size_type index) const noexcept { return std::bit_cast<const T*>(&_data[index]); }
+		constexpr T* ptr(size_type index) noexcept { return std::bit_cast<T*>(&_data[0]) + index; }
+		constexpr const T* ptr(size_type index) const noexcept { return std::bit_cast<const T*>(&_data[0]) + index; }
+
+		constexpr size_type index_of(const_iterator pos) const noexcept { return static_cast<size_type>(pos._ptr - &_data[0]); }
+
+		constexpr void copy_from(const StaticVector& other)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+				std::memcpy(static_cast<void*>(ptr(0)), static_cast<const void*>(other.ptr(0)), other._size * sizeof(T));
+			else
+				std::uninitialized_copy(other.ptr(0), other.ptr(other._size), ptr(0));
+			_size = other._size;
+		}
+
+		// Leaves other empty
+		constexpr void move_from(StaticVector& other)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+				std::memcpy(static_cast<void*>(ptr(0)), static_cast<const void*>(other.ptr(0)), other._size * sizeof(T));
+			else
+				std::uninitialized_move(other.ptr(0), other.ptr(other._size), ptr(0));
+			_size = other._size;
+			other.clear();
+		}
+
+		template <class Append>
+		constexpr void resize_with(size_type count, Append append)
+		{
+			if (count > Capacity)
+				throw std::length_error("StaticVector capacity exceeded");
+			if (count < _size)
+			{
+				std::destroy(ptr(count), ptr(_size));
+				_size = count;
+			}
+			while (_size < count) append();
+		}
 	};
 }
\ No newline at end of file
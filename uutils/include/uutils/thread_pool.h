@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace uutils
+{
+	// Work-stealing pool: every worker owns a deque, pops its own tasks LIFO and
+	// steals from the other workers FIFO when it runs dry.
+	class ThreadPool
+	{
+	public:
+		using Task = std::function<void()>;
+
+		explicit ThreadPool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+		{
+			threads = std::max<std::size_t>(threads, 1);
+			for (std::size_t i = 0; i < threads; ++i)
+				_queues.push_back(std::make_unique<Queue>());
+			for (std::size_t i = 0; i < threads; ++i)
+				_workers.emplace_back([this, i] { worker_loop(i); });
+		}
+
+		~ThreadPool()
+		{
+			{
+				std::lock_guard lock(_sleep_mutex);
+				_stopping = true;
+			}
+			_sleep_cv.notify_all();
+			for (auto& worker : _workers)
+				worker.join();
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		std::size_t size() const noexcept { return _workers.size(); }
+
+		void submit(Task task)
+		{
+			std::size_t index = current_worker() == this
+				? current_index()
+				: _next_queue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+			{
+				std::lock_guard lock(_sleep_mutex);
+				++_pending;
+			}
+			{
+				std::lock_guard lock(_queues[index]->mutex);
+				_queues[index]->tasks.push_back(std::move(task));
+			}
+			_sleep_cv.notify_one();
+		}
+
+		// Runs one queued task on the calling thread, if there is any.
+		bool run_pending_task()
+		{
+			Task task;
+			std::size_t home = current_worker() == this ? current_index() : 0;
+			if (!take_task(home, task)) return false;
+			task();
+			return true;
+		}
+
+		// Calls fn(i) for every i in [0, count), spreading the indices over at most
+		// max_workers threads (the calling thread included). Blocks until done and
+		// rethrows the first exception thrown by fn.
+		template <class Func>
+		void parallel_for(std::size_t count, Func&& fn, std::size_t max_workers = 0)
+		{
+			if (count == 0) return;
+			if (max_workers == 0) max_workers = size() + 1;
+			std::size_t runners = std::min(count, max_workers);
+
+			struct State
+			{
+				std::atomic<std::size_t> next{ 0 };
+				std::atomic<std::size_t> active{ 0 };
+				std::mutex error_mutex;
+				std::exception_ptr error;
+			} state;
+
+			auto run = [&state, &fn, count]
+			{
+				try
+				{
+					for (std::size_t i = state.next.fetch_add(1); i < count; i = state.next.fetch_add(1))
+						fn(i);
+				}
+				catch (...)
+				{
+					std::lock_guard lock(state.error_mutex);
+					if (!state.error) state.error = std::current_exception();
+					state.next.store(count);
+				}
+			};
+
+			state.active.store(runners - 1);
+			for (std::size_t i = 1; i < runners; ++i)
+			{
+				submit([&state, &run]
+				{
+					run();
+					state.active.fetch_sub(1, std::memory_order_release);
+				});
+			}
+
+			run();
+			while (state.active.load(std::memory_order_acquire) != 0)
+			{
+				if (!run_pending_task())
+					std::this_thread::yield();
+			}
+
+			if (state.error) std::rethrow_exception(state.error);
+		}
+
+		static ThreadPool& global()
+		{
+			static ThreadPool pool;
+			return pool;
+		}
+
+	private:
+		struct Queue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		std::vector<std::unique_ptr<Queue>> _queues;
+		std::vector<std::thread> _workers;
+		std::atomic<std::size_t> _next_queue{ 0 };
+
+		std::mutex _sleep_mutex;
+		std::condition_variable _sleep_cv;
+		std::size_t _pending = 0;
+		bool _stopping = false;
+
+		static ThreadPool*& current_worker() noexcept
+		{
+			thread_local ThreadPool* pool = nullptr;
+			return pool;
+		}
+
+		static std::size_t& current_index() noexcept
+		{
+			thread_local std::size_t index = 0;
+			return index;
+		}
+
+		bool take_task(std::size_t home, Task& task)
+		{
+			{
+				auto& own = *_queues[home];
+				std::lock_guard lock(own.mutex);
+				if (!own.tasks.empty())
+				{
+					task = std::move(own.tasks.back());
+					own.tasks.pop_back();
+					return acquired();
+				}
+			}
+			for (std::size_t i = 1; i < _queues.size(); ++i)
+			{
+				auto& victim = *_queues[(home + i) % _queues.size()];
+				std::lock_guard lock(victim.mutex);
+				if (!victim.tasks.empty())
+				{
+					task = std::move(victim.tasks.front());
+					victim.tasks.pop_front();
+					return acquired();
+				}
+			}
+			return false;
+		}
+
+		bool acquired()
+		{
+			std::lock_guard lock(_sleep_mutex);
+			--_pending;
+			return true;
+		}
+
+		void worker_loop(std::size_t index)
+		{
+			current_worker() = this;
+			current_index() = index;
+
+			Task task;
+			while (true)
+			{
+				if (take_task(index, task))
+				{
+					task();
+					task = nullptr;
+					continue;
+				}
+
+				std::unique_lock lock(_sleep_mutex);
+				_sleep_cv.wait(lock, [this] { return _stopping || _pending != 0; });
+				if (_stopping && _pending == 0) return;
+			}
+		}
+	};
+}
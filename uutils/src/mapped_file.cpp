@@ -0,0 +1,183 @@
+#include "uutils/mapped_file.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace uutils
+{
+	namespace
+	{
+		// Amount read ahead right after mapping with Advice::Sequential
+		constexpr std::size_t initial_readahead = std::size_t{ 8 } << 20;
+
+#ifdef _WIN32
+		[[noreturn]] void throw_last_error(const char* what)
+		{
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), what);
+		}
+#else
+		[[noreturn]] void throw_errno(const char* what)
+		{
+			throw std::system_error(errno, std::generic_category(), what);
+		}
+
+		int to_madvise(MappedFile::Advice advice)
+		{
+			switch (advice)
+			{
+			case MappedFile::Advice::Sequential: return MADV_SEQUENTIAL;
+			case MappedFile::Advice::Random: return MADV_RANDOM;
+			default: return MADV_NORMAL;
+			}
+		}
+#endif
+	}
+
+#ifdef _WIN32
+	MappedFile::MappedFile(const std::filesystem::path& path, Advice advice)
+	{
+		DWORD flags = advice == Advice::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : advice == Advice::Random ? FILE_FLAG_RANDOM_ACCESS : 0;
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | flags, nullptr);
+		if (file == INVALID_HANDLE_VALUE) throw_last_error("MappedFile: open");
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size))
+		{
+			CloseHandle(file);
+			throw_last_error("MappedFile: size");
+		}
+		_size = static_cast<std::size_t>(size.QuadPart);
+		if (_size == 0)
+		{
+			CloseHandle(file);
+			return;
+		}
+
+		_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (!_mapping) throw_last_error("MappedFile: map");
+
+		_data = static_cast<const std::byte*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+		if (!_data)
+		{
+			CloseHandle(_mapping);
+			throw_last_error("MappedFile: map");
+		}
+		if (advice == Advice::Sequential) prefetch(0, initial_readahead);
+	}
+
+	void MappedFile::advise(Advice) const noexcept
+	{
+		// Windows only takes access hints when the file is opened
+	}
+
+	void MappedFile::prefetch(std::size_t offset, std::size_t length) const noexcept
+	{
+		if (offset >= _size) return;
+		WIN32_MEMORY_RANGE_ENTRY range{ const_cast<std::byte*>(_data) + offset, std::min(length, _size - offset) };
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+
+	void MappedFile::unmap() noexcept
+	{
+		if (_data) UnmapViewOfFile(_data);
+		if (_mapping) CloseHandle(_mapping);
+		_data = nullptr;
+		_mapping = nullptr;
+		_size = 0;
+	}
+#else
+	MappedFile::MappedFile(const std::filesystem::path& path, Advice advice)
+	{
+		int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) throw_errno("MappedFile: open");
+
+		struct stat info;
+		if (::fstat(fd, &info) != 0)
+		{
+			int error = errno;
+			::close(fd);
+			throw std::system_error(error, std::generic_category(), "MappedFile: stat");
+		}
+		_size = static_cast<std::size_t>(info.st_size);
+		if (_size == 0)
+		{
+			::close(fd);
+			return;
+		}
+
+		void* p = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+		int error = errno;
+		// The mapping keeps its own reference to the file
+		::close(fd);
+		if (p == MAP_FAILED)
+		{
+			_size = 0;
+			throw std::system_error(error, std::generic_category(), "MappedFile: mmap");
+		}
+		_data = static_cast<const std::byte*>(p);
+
+		advise(advice);
+		if (advice == Advice::Sequential) prefetch(0, initial_readahead);
+	}
+
+	void MappedFile::advise(Advice advice) const noexcept
+	{
+		if (_data) ::madvise(const_cast<std::byte*>(_data), _size, to_madvise(advice));
+	}
+
+	void MappedFile::prefetch(std::size_t offset, std::size_t length) const noexcept
+	{
+		if (offset >= _size) return;
+		// madvise wants a page-aligned start
+		std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+		std::size_t start = offset / page * page;
+		std::size_t end = std::min(_size, offset + length);
+		::madvise(const_cast<std::byte*>(_data) + start, end - start, MADV_WILLNEED);
+	}
+
+	void MappedFile::unmap() noexcept
+	{
+		if (_data) ::munmap(const_cast<std::byte*>(_data), _size);
+		_data = nullptr;
+		_size = 0;
+	}
+#endif
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0))
+#ifdef _WIN32
+		, _mapping(std::exchange(other._mapping, nullptr))
+#endif
+	{
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			unmap();
+			_data = std::exchange(other._data, nullptr);
+			_size = std::exchange(other._size, 0);
+#ifdef _WIN32
+			_mapping = std::exchange(other._mapping, nullptr);
+#endif
+		}
+		return *this;
+	}
+
+	MappedFile::~MappedFile() { unmap(); }
+}